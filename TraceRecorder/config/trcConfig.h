@@ -165,6 +165,95 @@ extern "C" {
  */
 #define TRC_CFG_ENTRY_SYMBOL_MAX_LENGTH 28
 
+/**
+ * @def TRC_CFG_ENTRY_SYMBOL_POOL_SIZE
+ * @brief The size in bytes of a shared pool for symbol names. By default,
+ * every entry slot reserves room for a symbol of TRC_CFG_ENTRY_SYMBOL_MAX_LENGTH,
+ * even if it has no name or a short one. With a symbol pool, each symbol only
+ * takes its own length plus null termination, and identical names are stored
+ * once. TRC_CFG_ENTRY_SYMBOL_MAX_LENGTH then only limits the length of each
+ * name and can be raised without adding RAM per slot.
+ *
+ * Names are not removed from the pool when entries are deleted or renamed,
+ * so size the pool for all distinct names used. If the pool is full, new
+ * names are left empty and there will be a warning from TzCtrl task.
+ *
+ * Cannot be used with the RingBuffer stream port, where the host reads the
+ * entry table directly from memory.
+ *
+ * Default value is 0 (symbols are stored in the entry slots).
+ */
+#define TRC_CFG_ENTRY_SYMBOL_POOL_SIZE 0
+
+/**
+ * @def TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE
+ * @brief The number of used entries stored per critical section when tracing
+ * starts. With many entry slots, storing the whole entry table at once can
+ * keep interrupts disabled for a long time. A non-zero value stores the table
+ * in chunks of this many entries, with interrupts enabled in between. If an
+ * entry is created, deleted or renamed meanwhile, the recorder falls back to
+ * storing everything in one critical section.
+ *
+ * Only has effect when the stream port uses the internal event buffer.
+ *
+ * Default value is 0 (store the entry table in one critical section).
+ */
+#define TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE 0
+
+/**
+ * @def TRC_CFG_ENTRY_TABLE_HASH_INDEX
+ * @brief Keeps a hash index of the entry addresses, so that objects and tasks
+ * can be looked up by address without searching the whole entry table. This
+ * speeds up the "WithoutHandle" object APIs and task lookups when there are
+ * many entry slots. The index needs two bytes per bucket, with at least twice
+ * as many buckets as entry slots (rounded up to a power of two).
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_ENTRY_TABLE_HASH_INDEX 0
+
+/**
+ * @def TRC_CFG_STRING_REGISTRY_SIZE
+ * @brief The number of strings that xTraceStringRegister remembers. When a
+ * remembered string is registered again, the trace string from the first
+ * registration is returned, without using another entry slot or writing
+ * anything to the trace. This makes it safe to register user event channels
+ * where they are used, instead of keeping the handles around.
+ *
+ * Strings are matched by address and content. See also
+ * TRC_CFG_STRING_REGISTRY_MATCH_CONTENT. Only the first
+ * TRC_CFG_ENTRY_SYMBOL_MAX_LENGTH characters are compared. If more strings
+ * are registered, the rest are registered as usual but not reused.
+ *
+ * Default value is 0 (every registration creates a new trace string).
+ */
+#define TRC_CFG_STRING_REGISTRY_SIZE 0
+
+/**
+ * @def TRC_CFG_STRING_REGISTRY_MATCH_CONTENT
+ * @brief If 1, the string registry matches strings by content only, so equal
+ * strings at different addresses share one trace string. If 0, only strings
+ * registered from the same address are shared.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_STRING_REGISTRY_MATCH_CONTENT 0
+
+/**
+ * @def TRC_CFG_PRINT_CHANNEL_LIMITS
+ * @brief The number of user event channels that can be rate limited or
+ * sampled using xTracePrintSetChannelLimit() and
+ * xTracePrintCompactSetChannelLimit(). Suppressed events are counted per
+ * channel, and the counts are stored as user events by xTraceTzCtrl().
+ *
+ * When this is above 0, every user event looks up its channel among the
+ * limited channels, so keep it small. When it is 0, the functions above
+ * return TRC_FAIL.
+ *
+ * Default value is 0 (no channel limits).
+ */
+#define TRC_CFG_PRINT_CHANNEL_LIMITS 0
+
 /**
  * @def TRC_CFG_ENABLE_TASK_MONITOR
  * @brief Enable runtime supervision of CPU time usage per task.
@@ -254,6 +343,36 @@ extern "C" {
  */
 #define TRC_CFG_CTRL_TASK_DELAY 10
 
+/**
+ * @def TRC_CFG_CTRL_TASK_WAKEUP_LEVEL
+ * @brief Wakes the TzCtrl task before TRC_CFG_CTRL_TASK_DELAY has passed when
+ * the internal buffer of a core is filled to this level, in percent. This
+ * avoids dropped events during bursts without a short TRC_CFG_CTRL_TASK_DELAY.
+ *
+ * Only used with stream ports leveraging the internal buffer, and only if the
+ * kernel port can notify the TzCtrl task (FreeRTOS v9.0.0 or later with task
+ * notifications). The notification is sent from the next OS tick interrupt,
+ * not from the trace hook that filled the buffer. Set to 0 to disable.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_CTRL_TASK_WAKEUP_LEVEL 0
+
+/**
+ * @def TRC_CFG_CTRL_TASK_IDLE_DELAY
+ * @brief The longest delay between loops of the TzCtrl task. Only used if
+ * TRC_CFG_CTRL_TASK_WAKEUP_LEVEL is enabled.
+ *
+ * Each time TzCtrl wakes up by itself, without the internal buffer reaching
+ * TRC_CFG_CTRL_TASK_WAKEUP_LEVEL, the delay is doubled, up to this value. The
+ * delay goes back to TRC_CFG_CTRL_TASK_DELAY when the buffer level wakes it.
+ * This saves power while the system is idle, but also delays the handling of
+ * start and stop commands from Tracealyzer.
+ *
+ * Default value is 100.
+ */
+#define TRC_CFG_CTRL_TASK_IDLE_DELAY 100
+
 /**
  * @def TRC_CFG_CTRL_TASK_STACK_SIZE
  * @brief The stack size of the Tracealyzer Control (TzCtrl) task.
@@ -348,6 +467,265 @@ extern "C" {
  */
 #define TRC_CFG_RECORDER_DATA_ATTRIBUTE 
 
+/**
+ * @def TRC_CFG_USE_EVENT_BUFFER_RESERVATION
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), events written to a trace event buffer (the internal buffer or
+ * the RingBuffer stream port) only keep interrupts masked while the space is
+ * reserved in the per-core buffer. The event is then filled and committed with
+ * interrupts enabled, which reduces the interrupt latency caused by tracing.
+ * Events are only transferred once every event reserved before them has been
+ * committed, so a task that is preempted while filling an event holds back
+ * the events of other contexts until it resumes.
+ *
+ * Events are committed to the buffer they were reserved from, even if the
+ * task has migrated to another core in between.
+ * Has no effect for stream ports that write events directly.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_EVENT_BUFFER_RESERVATION 0
+
+/**
+ * @def TRC_CFG_EVENT_BUFFER_POW2_SIZE
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), the trace event buffers (the internal buffer and the RingBuffer
+ * stream port) wrap their indexes with a mask instead of a modulo operation.
+ * This avoids a software division on cores without a hardware divider, such
+ * as Cortex-M0 and RV32I.
+ *
+ * The event buffer of each core is then rounded down to the largest power of
+ * two that fits in its part of the buffer, after the buffer bookkeeping
+ * structures. To avoid wasting memory, make the buffer size slightly larger
+ * than a power of two per core.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_EVENT_BUFFER_POW2_SIZE 0
+
+/**
+ * @def TRC_CFG_EVENT_BUFFER_BLOCK_SIZE
+ * @brief The block size in bytes used for evicting old events from trace event
+ * buffers in overwrite mode, such as the RingBuffer stream port in
+ * TRC_STREAM_PORT_RINGBUFFER_MODE_OVERWRITE_WHEN_FULL mode.
+ *
+ * If zero (0), space is freed one event at a time, reading the size of each
+ * event to evict. Otherwise the buffer is divided into blocks of this size and
+ * a small index holding the first event of each block is kept after the event
+ * data (four bytes per block). Space is then freed a whole block at a time, so
+ * making room for a large event doesn't require decoding every event it
+ * overwrites inside the critical section. Up to one block of additional old
+ * events may be evicted.
+ *
+ * Must be zero or a power of two of at least 4.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_EVENT_BUFFER_BLOCK_SIZE 0
+
+/**
+ * @def TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS
+ * @brief Initializer for an array of TRC_CFG_CORE_COUNT weights that decides
+ * how the event buffer (the internal buffer or the RingBuffer stream port) is
+ * split between the cores on multi-core systems.
+ *
+ * Each core gets a share of the buffer proportional to its weight, e.g.
+ * { 3, 1 } gives core 0 three quarters of the buffer on a dual-core system.
+ * This lets a core with a high event rate use more of the buffer than a
+ * mostly idle core. All weights must be non-zero, except that all zeros
+ * splits the buffer evenly.
+ *
+ * Default value is { 0 }.
+ */
+#define TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS { 0 }
+
+/**
+ * @def TRC_CFG_USE_COMPACT_TIMESTAMPS
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), the 8 byte event header (event id, event count and timestamp)
+ * is replaced by a 4 byte header holding the event id and the timestamp delta
+ * from the previous event on the same core. Full timestamps and event counts
+ * are stored in timestamp sync events, written when a delta doesn't fit,
+ * after dropped events and every TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL
+ * events. This allows more events to be streamed over the same bandwidth.
+ *
+ * The delta is 16 bits, or 12 bits on multi-core systems. Only 32-bit
+ * platforms are supported, the build fails if TRC_BASE_TYPE is not 32-bit.
+ * Requires a Tracealyzer version that supports trace format version 15.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_COMPACT_TIMESTAMPS 0
+
+/**
+ * @def TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL
+ * @brief The maximum number of events per core between two timestamp sync
+ * events when TRC_CFG_USE_COMPACT_TIMESTAMPS is enabled. Lower values let
+ * Tracealyzer resynchronize faster if data is lost, at a small bandwidth cost.
+ *
+ * Default value is 256.
+ */
+#define TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL 256
+
+/**
+ * @def TRC_CFG_USE_PACKED_EVENT_PARAMETERS
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), events created with xTraceEventCreate1 to xTraceEventCreate6
+ * store their parameters as variable length integers instead of one
+ * TraceUnsignedBaseType_t each. Small values such as priorities, counts and
+ * -1 then take a single byte, which mostly helps 64-bit targets. Packing costs
+ * a few extra cycles per parameter, done before entering the critical section.
+ *
+ * Payload events are limited to 14 parameters (words) in this mode. Requires
+ * a Tracealyzer version that supports trace format version 15.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_PACKED_EVENT_PARAMETERS 0
+
+/**
+ * @def TRC_CFG_USE_EVENT_GROUP_FILTER
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), event groups can be enabled and disabled at runtime, either
+ * from Tracealyzer or with xTraceEventGroupEnable/xTraceEventGroupDisable.
+ * An event group holds 16 consecutive event codes, e.g. 0x30-0x3F. Events in
+ * disabled groups are discarded before any buffer space is allocated. This
+ * allows one build to be narrowed down to the events of interest, unlike the
+ * TRC_CFG_INCLUDE_* settings which require a rebuild.
+ *
+ * Uses 32 bytes of RAM and adds a bit test to every event.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_EVENT_GROUP_FILTER 0
+
+/**
+ * @def TRC_CFG_INLINE_EVENT_CREATE
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), the kernel port hooks create fixed-parameter events through
+ * static inline versions of xTraceEventCreate0 to xTraceEventCreate6 instead
+ * of calling them. This removes the call overhead and lets the compiler fold
+ * constant event codes and sizes, which matters most on small cores such as
+ * Cortex-M0+, at the cost of larger code at every trace hook.
+ *
+ * Requires a compiler that supports static inline functions. Can't be
+ * combined with TRC_CFG_USE_EVENT_COALESCING or
+ * TRC_CFG_USE_PACKED_EVENT_PARAMETERS, since those create events out of line.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_INLINE_EVENT_CREATE 0
+
+/**
+ * @def TRC_CFG_USE_EVENT_COALESCING
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), an event created with xTraceEventCreate0 to xTraceEventCreate6
+ * that repeats the previous such event on the same core is counted instead of
+ * written. The event code and parameters must match, see also
+ * TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT. The count is written as one PSF_EVENT_REPEAT event holding the number of
+ * repeats and the timestamp of the last one, when a different event is
+ * created, when a repeat comes more than TRC_CFG_EVENT_COALESCING_WINDOW
+ * timestamp ticks after the event that started the run or when xTraceTzCtrl
+ * runs. This keeps OS tick events and counters set to the same value from
+ * flooding the stream while the system is idle, but the timestamps of the
+ * individual repeats are lost. Each repeat still advances the event counter
+ * and is included in the event statistics, see TRC_CFG_USE_EVENT_STATISTICS.
+ *
+ * Requires a Tracealyzer version that supports trace format version 15.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_EVENT_COALESCING 0
+
+/**
+ * @def TRC_CFG_EVENT_COALESCING_WINDOW
+ * @brief The time, in timestamp ticks, that a run of repeats may span. A
+ * repeat that comes later than this after the event that started the run
+ * ends the run and is written as a normal event, so an idle system still
+ * shows up in the trace at this interval. Only used if
+ * TRC_CFG_USE_EVENT_COALESCING is 1.
+ *
+ * Default value is 16777216, about 0.17 seconds with a 100 MHz timestamp
+ * clock.
+ */
+#define TRC_CFG_EVENT_COALESCING_WINDOW 16777216
+
+/**
+ * @def TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), an event whose last parameter is one more than in the previous
+ * event also counts as a repeat, as the tick count of OS tick events does.
+ * The PSF_EVENT_REPEAT event then also holds that increase, so the host can
+ * rebuild the parameter of each repeat. Only used when
+ * TRC_CFG_USE_EVENT_COALESCING is 1.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT 0
+
+/**
+ * @def TRC_CFG_USE_EVENT_STATISTICS
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * If one (1), the recorder counts the events and bytes written for each event
+ * code. Repeats coalesced by TRC_CFG_USE_EVENT_COALESCING are counted as
+ * events without bytes. The counts can be read with xTraceEventStatisticsGet and are reported
+ * by xTraceTzCtrl as PSF_EVENT_EVENT_STATISTICS events holding the event code,
+ * event count and byte count. This shows which event codes use the streaming
+ * bandwidth without analyzing a whole trace.
+ *
+ * Uses 8 bytes of RAM per event code, see TRC_CFG_EVENT_STATISTICS_CODES.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_EVENT_STATISTICS 0
+
+/**
+ * @def TRC_CFG_EVENT_STATISTICS_CODES
+ * @brief The number of event codes, starting from 0, that have their own
+ * statistics. Higher event codes share one extra entry. Only used if
+ * TRC_CFG_USE_EVENT_STATISTICS is 1.
+ *
+ * Default value is 512, which covers the event codes of all kernel ports
+ * except ThreadX.
+ */
+#define TRC_CFG_EVENT_STATISTICS_CODES 512
+
+/**
+ * @def TRC_CFG_EVENT_STATISTICS_MAX_REPORTS
+ * @brief The maximum number of event codes reported each time xTraceTzCtrl
+ * runs. Event codes without events are skipped. Only used if
+ * TRC_CFG_USE_EVENT_STATISTICS is 1.
+ *
+ * Default value is 4.
+ */
+#define TRC_CFG_EVENT_STATISTICS_MAX_REPORTS 4
+
+/**
+ * @def TRC_CFG_USE_DROPPED_EVENT_MARKERS
+ * @brief Macro which should be defined as either zero (0) or one (1).
+ *
+ * Events that don't fit in a full trace buffer are dropped when
+ * TRC_EVENT_BUFFER_OPTION_SKIP is used.
+ *
+ * If one (1), the recorder counts the dropped events and bytes for each core,
+ * see xTraceEventDroppedGet, and the next event that fits is preceded by a
+ * PSF_EVENT_EVENTS_LOST event holding the number of events and bytes that were
+ * lost and the timestamps of the first and the last of them, so the gap shows
+ * in the trace.
+ *
+ * Default value is 0.
+ */
+#define TRC_CFG_USE_DROPPED_EVENT_MARKERS 0
+
 /**
  * @def TRC_CFG_USE_TRACE_ASSERT
  * @brief Enable or disable debug asserts. Information regarding any assert that is
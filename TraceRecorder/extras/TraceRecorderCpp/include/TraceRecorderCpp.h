@@ -0,0 +1,387 @@
+/*
+ * Percepio Trace Recorder C++ Front-end v4.11.1
+ * Copyright 2025 Percepio AB
+ * www.percepio.com
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Header-only C++17 layer on top of the Trace Recorder C APIs. It is only
+ * needed in projects that trace from C++ code and want type-safe calls.
+ *
+ * Usage:
+ *	Add the include folder to the include path and include this file.
+ *	No source files need to be added to the project.
+ *
+ *	Print calls pack their arguments at compile time and create the event
+ *	directly, without the va_list path used by xTracePrintF(). Arguments may
+ *	be integers, enums, pointers, floats and doubles. Values wider than
+ *	TraceUnsignedBaseType_t, e.g. uint64_t and double on 32-bit targets, use
+ *	two parameter slots (low word first) instead of being truncated. Floats
+ *	and doubles are stored as their raw IEEE-754 bits.
+ */
+
+#pragma once
+
+#include <trcRecorder.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace TraceRecorderCpp
+{
+	namespace Detail
+	{
+		/* Number of parameter slots an argument of type T occupies */
+		template <typename T>
+		constexpr std::size_t ArgSlots()
+		{
+			using Arg = std::decay_t<T>;
+
+			static_assert(std::is_arithmetic_v<Arg> || std::is_enum_v<Arg> || std::is_pointer_v<Arg> || std::is_null_pointer_v<Arg>,
+				"Trace arguments must be integers, enums, pointers or floating point values");
+			static_assert(sizeof(Arg) <= 8u, "Trace arguments can be at most 64 bits wide");
+
+			return (sizeof(Arg) + sizeof(TraceUnsignedBaseType_t) - 1u) / sizeof(TraceUnsignedBaseType_t);
+		}
+
+		template <typename... Args>
+		constexpr std::size_t SlotCount()
+		{
+			return (ArgSlots<Args>() + ... + 0u);
+		}
+
+		inline void PackWide(TraceUnsignedBaseType_t* puxSlots, std::size_t& uxIndex, uint64_t ulValue)
+		{
+			if constexpr (sizeof(TraceUnsignedBaseType_t) >= sizeof(uint64_t))
+			{
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(ulValue);
+			}
+			else
+			{
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(ulValue & 0xFFFFFFFFu);
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(ulValue >> 32);
+			}
+		}
+
+		template <typename T>
+		inline void PackArg(TraceUnsignedBaseType_t* puxSlots, std::size_t& uxIndex, T xArg)
+		{
+			if constexpr (std::is_enum_v<T>)
+			{
+				PackArg(puxSlots, uxIndex, static_cast<std::underlying_type_t<T>>(xArg));
+			}
+			else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+			{
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(xArg));
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				if constexpr (sizeof(T) == sizeof(uint32_t))
+				{
+					uint32_t uiBits;
+
+					std::memcpy(&uiBits, &xArg, sizeof(uiBits));
+					puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(uiBits);
+				}
+				else
+				{
+					uint64_t ulBits;
+
+					static_assert(sizeof(T) == sizeof(uint64_t), "Unsupported floating point size");
+					std::memcpy(&ulBits, &xArg, sizeof(ulBits));
+					PackWide(puxSlots, uxIndex, ulBits);
+				}
+			}
+			else if constexpr (sizeof(T) > sizeof(TraceUnsignedBaseType_t))
+			{
+				PackWide(puxSlots, uxIndex, static_cast<uint64_t>(xArg));
+			}
+			else if constexpr (std::is_signed_v<T>)
+			{
+				/* Sign extend to the full parameter width */
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(static_cast<TraceBaseType_t>(xArg));
+			}
+			else
+			{
+				puxSlots[uxIndex++] = static_cast<TraceUnsignedBaseType_t>(xArg);
+			}
+		}
+
+		/* Always at least one element so that zero arguments doesn't give a zero sized array */
+		template <std::size_t N>
+		struct Slots
+		{
+			TraceUnsignedBaseType_t auxValues[N > 0u ? N : 1u];
+		};
+
+		template <typename... Args>
+		inline Slots<SlotCount<Args...>()> Pack(Args... args)
+		{
+			Slots<SlotCount<Args...>()> xSlots = {};
+			std::size_t uxIndex = 0u;
+
+			(PackArg(xSlots.auxValues, uxIndex, args), ...);
+			(void)uxIndex;
+
+			return xSlots;
+		}
+	}
+
+	/**
+	 * @brief Generates a "User Event" with typed arguments.
+	 *
+	 * Produces the same event as xTracePrintF(), but the arguments are packed at
+	 * compile time and the event is created directly using
+	 * xTraceEventCreateDataN(). The format string must be a string literal, whose
+	 * length is taken from its type. At most 5 parameter slots are available,
+	 * which is checked at compile time.
+	 *
+	 * The channel must have been registered using xTraceStringRegister().
+	 *
+	 * Example:
+	 *	TraceRecorderCpp::PrintF(xChannel, "Speed %d, %u", iSpeed, uiCount);
+	 *
+	 * @param[in] xChannel Channel handle.
+	 * @param[in] szFormat Format string literal.
+	 * @param[in] args Arguments.
+	 *
+	 * @retval TRC_FAIL Failure
+	 * @retval TRC_SUCCESS Success
+	 */
+	template <std::size_t N, typename... Args>
+	inline traceResult PrintF(TraceStringHandle_t xChannel, const char (&szFormat)[N], Args... args)
+	{
+		constexpr std::size_t uxSlotCount = Detail::SlotCount<Args...>();
+
+		static_assert(uxSlotCount <= 5u, "PrintF supports at most 5 parameter slots");
+
+#if (TRC_USE_TRACEALYZER_RECORDER == 1) && (TRC_CFG_INCLUDE_USER_EVENTS == 1)
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+		if (xTracePrintChannelCheck(static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(xChannel))) == TRC_FAIL)
+		{
+			return TRC_SUCCESS;
+		}
+#endif
+
+		const auto xSlots = Detail::Pack(args...);
+		const TraceUnsignedBaseType_t* const puxFormat = reinterpret_cast<const TraceUnsignedBaseType_t*>(szFormat);
+		const uint32_t uiEventCode = PSF_EVENT_USER_EVENT + 1u + static_cast<uint32_t>(uxSlotCount); /* Add channel (1) */
+		const TraceUnsignedBaseType_t uxChannel = static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(xChannel));
+		const TraceUnsignedBaseType_t* const puxSlots = xSlots.auxValues;
+
+		if constexpr (uxSlotCount == 0u)
+		{
+			(void)puxSlots;
+			return xTraceEventCreateData1(uiEventCode, uxChannel, puxFormat, N);
+		}
+		else if constexpr (uxSlotCount == 1u)
+		{
+			return xTraceEventCreateData2(uiEventCode, uxChannel, puxSlots[0], puxFormat, N);
+		}
+		else if constexpr (uxSlotCount == 2u)
+		{
+			return xTraceEventCreateData3(uiEventCode, uxChannel, puxSlots[0], puxSlots[1], puxFormat, N);
+		}
+		else if constexpr (uxSlotCount == 3u)
+		{
+			return xTraceEventCreateData4(uiEventCode, uxChannel, puxSlots[0], puxSlots[1], puxSlots[2], puxFormat, N);
+		}
+		else if constexpr (uxSlotCount == 4u)
+		{
+			return xTraceEventCreateData5(uiEventCode, uxChannel, puxSlots[0], puxSlots[1], puxSlots[2], puxSlots[3], puxFormat, N);
+		}
+		else
+		{
+			return xTraceEventCreateData6(uiEventCode, uxChannel, puxSlots[0], puxSlots[1], puxSlots[2], puxSlots[3], puxSlots[4], puxFormat, N);
+		}
+#else
+		(void)xChannel;
+		(void)szFormat;
+		((void)args, ...);
+
+		return TRC_SUCCESS;
+#endif
+	}
+
+	/**
+	 * @brief Generates a compact "User Event" with typed arguments.
+	 *
+	 * Same as PrintF(), but dispatches to the PSF_EVENT_USER_EVENT_FIXED events
+	 * used by xTracePrintCompactF0() - xTracePrintCompactF4(). The channel and
+	 * format strings are stored as addresses and must have static storage. At
+	 * most 4 parameter slots are available.
+	 *
+	 * Example:
+	 *	TraceRecorderCpp::PrintCompactF("MyChannel", "Speed %d", iSpeed);
+	 *
+	 * @param[in] szChannel Channel string.
+	 * @param[in] szFormat Format string.
+	 * @param[in] args Arguments.
+	 *
+	 * @retval TRC_FAIL Failure
+	 * @retval TRC_SUCCESS Success
+	 */
+	template <typename... Args>
+	inline traceResult PrintCompactF(const char* szChannel, const char* szFormat, Args... args)
+	{
+		constexpr std::size_t uxSlotCount = Detail::SlotCount<Args...>();
+
+		static_assert(uxSlotCount <= 4u, "PrintCompactF supports at most 4 parameter slots");
+
+#if (TRC_USE_TRACEALYZER_RECORDER == 1) && (TRC_CFG_INCLUDE_USER_EVENTS == 1)
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+		if (xTracePrintChannelCheck(static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(szChannel))) == TRC_FAIL)
+		{
+			return TRC_SUCCESS;
+		}
+#endif
+
+		const auto xSlots = Detail::Pack(args...);
+		const uint32_t uiEventCode = PSF_EVENT_USER_EVENT_FIXED + static_cast<uint32_t>(uxSlotCount);
+		const TraceUnsignedBaseType_t uxChannel = static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(szChannel));
+		const TraceUnsignedBaseType_t uxFormat = static_cast<TraceUnsignedBaseType_t>(reinterpret_cast<uintptr_t>(szFormat));
+		const TraceUnsignedBaseType_t* const puxSlots = xSlots.auxValues;
+
+		if constexpr (uxSlotCount == 0u)
+		{
+			(void)puxSlots;
+			return xTraceEventCreate2(uiEventCode, uxChannel, uxFormat);
+		}
+		else if constexpr (uxSlotCount == 1u)
+		{
+			return xTraceEventCreate3(uiEventCode, uxChannel, uxFormat, puxSlots[0]);
+		}
+		else if constexpr (uxSlotCount == 2u)
+		{
+			return xTraceEventCreate4(uiEventCode, uxChannel, uxFormat, puxSlots[0], puxSlots[1]);
+		}
+		else if constexpr (uxSlotCount == 3u)
+		{
+			return xTraceEventCreate5(uiEventCode, uxChannel, uxFormat, puxSlots[0], puxSlots[1], puxSlots[2]);
+		}
+		else
+		{
+			return xTraceEventCreate6(uiEventCode, uxChannel, uxFormat, puxSlots[0], puxSlots[1], puxSlots[2], puxSlots[3]);
+		}
+#else
+		(void)szChannel;
+		(void)szFormat;
+		((void)args, ...);
+
+		return TRC_SUCCESS;
+#endif
+	}
+
+	/**
+	 * @brief Interval that starts when constructed and stops when it goes out of scope.
+	 *
+	 * Example:
+	 *	{
+	 *		TraceRecorderCpp::ScopedInterval xInterval(xIntervalChannel);
+	 *		...
+	 *	}
+	 */
+	class ScopedInterval
+	{
+	public:
+		explicit ScopedInterval(TraceIntervalChannelHandle_t xIntervalChannelHandle, TraceUnsignedBaseType_t uxValue = 0u)
+			: xChannel(xIntervalChannelHandle), xInstance(nullptr)
+		{
+			(void)xTraceIntervalStart(xChannel, uxValue, &xInstance);
+		}
+
+		~ScopedInterval()
+		{
+			(void)xTraceIntervalStop(xChannel, xInstance);
+		}
+
+		ScopedInterval(const ScopedInterval&) = delete;
+		ScopedInterval& operator=(const ScopedInterval&) = delete;
+
+	private:
+		TraceIntervalChannelHandle_t xChannel;
+		TraceIntervalInstanceHandle_t xInstance;
+	};
+
+	/**
+	 * @brief Wrapper for a trace state machine and its states.
+	 *
+	 * Objects may be global, since nothing is traced until Create() is called.
+	 */
+	class StateMachine
+	{
+	public:
+		traceResult Create(const char* szName)
+		{
+			return xTraceStateMachineCreate(szName, &xHandle);
+		}
+
+		traceResult CreateState(const char* szName, TraceStateMachineStateHandle_t* pxStateHandle)
+		{
+			return xTraceStateMachineStateCreate(xHandle, szName, pxStateHandle);
+		}
+
+		traceResult SetState(TraceStateMachineStateHandle_t xStateHandle)
+		{
+			return xTraceStateMachineSetState(xHandle, xStateHandle);
+		}
+
+		TraceStateMachineHandle_t GetHandle() const
+		{
+			return xHandle;
+		}
+
+	private:
+		TraceStateMachineHandle_t xHandle = nullptr;
+	};
+
+	/**
+	 * @brief Wrapper for a trace counter.
+	 *
+	 * Objects may be global, since nothing is traced until Create() is called.
+	 */
+	class Counter
+	{
+	public:
+		traceResult Create(const char* szName, TraceBaseType_t xInitialValue, TraceBaseType_t xLowerLimit, TraceBaseType_t xUpperLimit)
+		{
+			return xTraceCounterCreate(szName, xInitialValue, xLowerLimit, xUpperLimit, &xHandle);
+		}
+
+		traceResult Set(TraceBaseType_t xValue)
+		{
+			return xTraceCounterSet(xHandle, xValue);
+		}
+
+		traceResult Add(TraceBaseType_t xValue)
+		{
+			TraceBaseType_t xCurrent = 0;
+
+			if (xTraceCounterGet(xHandle, &xCurrent) == TRC_FAIL)
+			{
+				return TRC_FAIL;
+			}
+
+			return xTraceCounterSet(xHandle, xCurrent + xValue);
+		}
+
+		traceResult Increase()
+		{
+			return Add(1);
+		}
+
+		traceResult Decrease()
+		{
+			return Add(-1);
+		}
+
+		TraceCounterHandle_t GetHandle() const
+		{
+			return xHandle;
+		}
+
+	private:
+		TraceCounterHandle_t xHandle = nullptr;
+	};
+}
@@ -34,9 +34,10 @@
 
 /* Command codes for TzCtrl task */
 #define CMD_SET_ACTIVE      1 /* Start (param1 = 1) or Stop (param1 = 0) */
+#define CMD_SET_EVENT_GROUP_FILTER 2 /* Enable (param3 = 1) or disable (param3 = 0) event groups param1 to param2 */
 
 /* The final command code, used to validate commands. */
-#define CMD_LAST_COMMAND 1
+#define CMD_LAST_COMMAND 2
 
 #define TRC_RECORDER_BUFFER_ALLOCATION_STATIC   (0x00UL)
 #define TRC_RECORDER_BUFFER_ALLOCATION_DYNAMIC  (0x01UL)
@@ -66,6 +67,7 @@
 #define TRC_WARNING_STREAM_PORT_WRITE				0x0CUL
 #define TRC_WARNING_STREAM_PORT_INITIAL_BLOCKING	0x0DUL
 #define TRC_WARNING_STACKMON_NO_SLOTS				0x0EUL
+#define TRC_WARNING_ENTRY_SYMBOL_POOL				0x0FUL
 
 /* Entry Option definitions */
 #define TRC_ENTRY_OPTION_EXCLUDED				0x00000001UL
@@ -108,10 +110,14 @@
 #define TRC_RECORDER_COMPONENT_TASK_MONITOR				0x00800000UL
 
 /**
- *
+ * Values for TRC_CFG_STREAM_PORT_INTERNAL_BUFFER_TRANSFER_MODE, set in the stream port config.
+ * ALL transfers all buffered data each time, CHUNKED a chunk at a time. MERGED transfers chunks
+ * with the events of all cores ordered by timestamp, for multi-core systems where the stream port
+ * has a single stream.
  */
 #define TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_ALL		(0U)
 #define TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_CHUNKED	(1U)
+#define TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED	(2U)
 
 /******************************************************************************
  * Supported ports
@@ -23,7 +23,7 @@
 extern "C" {
 #endif
 
-#define TRC_DIAGNOSTICS_COUNT 5UL
+#define TRC_DIAGNOSTICS_COUNT 6UL
 
 typedef enum TraceDiagnosticsType
 {
@@ -32,6 +32,7 @@ typedef enum TraceDiagnosticsType
 	TRC_DIAGNOSTICS_BLOB_MAX_BYTES_TRUNCATED = 0x02UL,
 	TRC_DIAGNOSTICS_STACK_MONITOR_NO_SLOTS = 0x03UL,
 	TRC_DIAGNOSTICS_ASSERTS_TRIGGERED = 0x04UL,
+	TRC_DIAGNOSTICS_ENTRY_SYMBOL_POOL_NO_ROOM = 0x05UL,
 } TraceDiagnosticsType_t;
 
 typedef struct TraceDiagnostics /* Aligned */
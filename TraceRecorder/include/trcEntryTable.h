@@ -29,20 +29,50 @@ extern "C" {
  * @{
  */
 
+/* Unless specified in trcConfig.h entries are found by searching the whole entry table */
+#ifndef TRC_CFG_ENTRY_TABLE_HASH_INDEX
+#define TRC_CFG_ENTRY_TABLE_HASH_INDEX 0
+#endif
+
+/* Unless specified in trcConfig.h every entry slot has room for a full length symbol */
+#ifndef TRC_CFG_ENTRY_SYMBOL_POOL_SIZE
+#define TRC_CFG_ENTRY_SYMBOL_POOL_SIZE 0
+#endif
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+/* The address is part of the hash index, so it must be set when the entry is created */
+#define TRC_ENTRY_CREATE_WITH_ADDRESS(_pvAddress, _pxEntryHandle) xTraceEntryCreateIndexed(_pvAddress, _pxEntryHandle)
+#else
 #define TRC_ENTRY_CREATE_WITH_ADDRESS(_pvAddress, _pxEntryHandle) (xTraceEntryCreate(_pxEntryHandle) == TRC_SUCCESS ? (((TraceEntry_t*)*(_pxEntryHandle))->pvAddress = (_pvAddress), TRC_SUCCESS) : TRC_FAIL)
+#endif
 #define TRC_ENTRY_SET_STATE(xEntryHandle, uxStateIndex, uxState) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(((TraceEntry_t*)(xEntryHandle))->xStates[uxStateIndex] = (uxState), TRC_SUCCESS)
 #define TRC_ENTRY_SET_OPTIONS(xEntryHandle, uiMask) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(((TraceEntry_t*)(xEntryHandle))->uiOptions |= (uiMask), TRC_SUCCESS)
 #define TRC_ENTRY_CLEAR_OPTIONS(xEntryHandle, uiMask) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(((TraceEntry_t*)(xEntryHandle))->uiOptions &= ~(uiMask), TRC_SUCCESS)
 #define TRC_ENTRY_GET_ADDRESS(xEntryHandle, ppvAddress) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(*(ppvAddress) = ((TraceEntry_t*)(xEntryHandle))->pvAddress, TRC_SUCCESS)
 #define TRC_ENTRY_GET_ADDRESS_RETURN(xEntryHandle) (((TraceEntry_t*)(xEntryHandle))->pvAddress)
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+/* Symbols are kept in the symbol pool, which is only accessible from trcEntryTable.c */
+#define TRC_ENTRY_GET_SYMBOL(xEntryHandle, pszSymbol) xTraceEntryGetPooledSymbol(xEntryHandle, pszSymbol)
+#else
 #define TRC_ENTRY_GET_SYMBOL(xEntryHandle, pszSymbol) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(*(pszSymbol) = ((TraceEntry_t*)(xEntryHandle))->szSymbol, TRC_SUCCESS)
+#endif
 #define TRC_ENTRY_GET_STATE(xEntryHandle, uxStateIndex, puxState) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(*(puxState) = ((TraceEntry_t*)(xEntryHandle))->xStates[uxStateIndex], TRC_SUCCESS)
 #define TRC_ENTRY_GET_STATE_RETURN(xEntryHandle, uxStateIndex) (((TraceEntry_t*)(xEntryHandle))->xStates[uxStateIndex])
 #define TRC_ENTRY_GET_OPTIONS(xEntryHandle, puiOptions) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2(*(puiOptions) = ((TraceEntry_t*)(xEntryHandle))->uiOptions, TRC_SUCCESS)
 
+/* Unless specified in trcConfig.h the entry table is stored in one critical section */
+#ifndef TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE
+#define TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE 0
+#endif
+
 #define TRC_ENTRY_TABLE_STATE_COUNT (3UL)
 #define TRC_ENTRY_TABLE_SYMBOL_LENGTH  ((uint32_t)(TRC_CFG_ENTRY_SYMBOL_MAX_LENGTH))
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+/* The symbol pool size is aligned to 64-bit */
+#define TRC_ENTRY_SYMBOL_POOL_SIZE (((uint32_t)(TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) + 7UL) & ~7UL)
+#endif
+
 /* TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE has to be aligned to TraceUnsignedBaseType_t but with a uint32_t padding to ensure that TraceEntry_t size is aligned (uiOptions is uint32_t) */
 #define TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE (((((sizeof(char) * (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH) - sizeof(uint32_t)) + (sizeof(TraceUnsignedBaseType_t) - 1UL)) / sizeof(TraceUnsignedBaseType_t)) * sizeof(TraceUnsignedBaseType_t)) + sizeof(uint32_t))
 
@@ -56,13 +86,71 @@ typedef uint8_t TraceEntryIndex_t;
 
 #define TRC_ENTRY_TABLE_SLOTS ((((TRC_CFG_ENTRY_SLOTS) + (TRC_ENTRY_INDEX_ALIGNMENT_MULTIPLE) - 1) / TRC_ENTRY_INDEX_ALIGNMENT_MULTIPLE) * TRC_ENTRY_INDEX_ALIGNMENT_MULTIPLE)
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+/* The hash index has at least twice as many buckets as there are entry slots, rounded up to a power of two */
+#define TRC_ENTRY_HASH_MIN_BUCKETS ((uint32_t)(TRC_ENTRY_TABLE_SLOTS) * 2UL)
+#define TRC_ENTRY_HASH_BUCKETS \
+	((TRC_ENTRY_HASH_MIN_BUCKETS <= 64UL) ? 64UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 128UL) ? 128UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 256UL) ? 256UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 512UL) ? 512UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 1024UL) ? 1024UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 2048UL) ? 2048UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 4096UL) ? 4096UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 8192UL) ? 8192UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 16384UL) ? 16384UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 32768UL) ? 32768UL : \
+	(TRC_ENTRY_HASH_MIN_BUCKETS <= 65536UL) ? 65536UL : 131072UL)
+
+/* Hash buckets store entry index + 1 as uint16_t */
+#if ((TRC_ENTRY_TABLE_SLOTS) > 0xFFFF)
+#error TRC_CFG_ENTRY_TABLE_HASH_INDEX supports at most 65535 entry slots!
+#endif
+#endif
+
 typedef struct EntryIndexTable	/* Aligned because TRC_ENTRY_TABLE_SLOTS is always a multiple that aligns to 64-bit */
 {
 	TraceEntryIndex_t axFreeIndexes[TRC_ENTRY_TABLE_SLOTS];	/* slot count and size is aligned to 64-bit */
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	uint16_t auiHashBuckets[TRC_ENTRY_HASH_BUCKETS];	/* Entry index + 1 per bucket, 0 when empty. Bucket count aligns to 64-bit */
+#endif
 	uint32_t uiFreeIndexCount;
-	uint32_t reserved;			/* alignment */
+	uint32_t uiChangeCount;		/* Incremented when an entry is created, deleted, renamed or modified */
 } TraceEntryIndexTable_t;
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+
+/** Trace Entry Structure */
+typedef struct TraceEntry	/* Aligned because uiOptions and uiSymbolOffset together are 64-bit */
+{
+	void* pvAddress;												/**< */
+	TraceUnsignedBaseType_t xStates[TRC_ENTRY_TABLE_STATE_COUNT];	/**< */
+	uint32_t uiOptions;												/**< */
+	uint32_t uiSymbolOffset;										/**< Offset of the symbol in the symbol pool */
+} TraceEntry_t;
+
+/** Trace Entry as stored to the host, with the symbol copied from the symbol pool */
+typedef struct TraceEntryStored	/* Aligned because TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE will align together with uiOptions */
+{
+	void* pvAddress;												/**< */
+	TraceUnsignedBaseType_t xStates[TRC_ENTRY_TABLE_STATE_COUNT];	/**< */
+	uint32_t uiOptions;												/**< */
+	char szSymbol[TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE];				/**< */
+} TraceEntryStored_t;
+
+typedef struct TraceEntryTable	/* Aligned */
+{
+	TraceUnsignedBaseType_t uxSlots;
+	TraceUnsignedBaseType_t uxEntrySymbolLength;
+	TraceUnsignedBaseType_t uxEntryStateCount;
+	TraceEntry_t axEntries[TRC_ENTRY_TABLE_SLOTS];
+	uint32_t uiSymbolPoolUsed;										/* Bytes used in acSymbolPool */
+	uint32_t reserved;												/* alignment */
+	char acSymbolPool[TRC_ENTRY_SYMBOL_POOL_SIZE];					/* Null terminated symbols, each stored once. Starts with an empty symbol. */
+} TraceEntryTable_t;
+
+#else /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
+
 /** Trace Entry Structure */
 typedef struct TraceEntry	/* Aligned because TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE will align together with uiOptions */
 {
@@ -80,6 +168,8 @@ typedef struct TraceEntryTable	/* Aligned */
 	TraceEntry_t axEntries[TRC_ENTRY_TABLE_SLOTS];
 } TraceEntryTable_t;
 
+#endif /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
+
 /**
  * @internal Initialize trace entry index table.
  * 
@@ -116,6 +206,20 @@ traceResult xTraceEntryTableInitialize(TraceEntryTable_t* const pxBuffer);
  */
 traceResult xTraceEntryCreate(TraceEntryHandle_t *pxEntryHandle);
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+/**
+ * @internal Creates trace entry mapped to memory address and adds it to the
+ * hash index. Used by xTraceEntryCreateWithAddress.
+ * 
+ * @param[in] pvAddress Address.
+ * @param[out] pxEntryHandle Pointer to uninitialized trace entry handle.
+ * 
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEntryCreateIndexed(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle);
+#endif
+
 /**
  * @brief Deletes trace entry.
  * 
@@ -148,74 +252,80 @@ traceResult xTraceEntryFind(const void* const pvAddress, TraceEntryHandle_t* pxE
 traceResult xTraceEntryGetCount(uint32_t* puiCount);
 
 /**
- * @brief Gets trace table entry at index. 
+ * @brief Gets the change count of the trace entry table. The count is
+ * incremented every time an entry is created, deleted, given a new symbol or
+ * has its states or options changed,
+ * which lets the entry table be stored in several steps and still be checked
+ * for consistency.
  * 
- * @param[in] index Entry index.
- * @param[out] pxEntryHandle Pointer to uninitialized trace entry handle. 
+ * @param[out] puiChangeCount Change count.
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntryGetAtIndex(uint32_t index, TraceEntryHandle_t* pxEntryHandle);
+traceResult xTraceEntryGetChangeCount(uint32_t* puiChangeCount);
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
 /**
- * @brief Sets symbol for entry.
+ * @internal Gets the symbol of a trace entry from the symbol pool.
+ * Used by xTraceEntryGetSymbol.
  * 
  * @param[in] xEntryHandle Pointer to initialized trace entry handle.
- * @param[in] szSymbol Pointer to symbol string, set by function
- * @param[in] uiLength Symbol length
+ * @param[out] pszSymbol Symbol.
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntrySetSymbol(const TraceEntryHandle_t xEntryHandle, const char* szSymbol, uint32_t uiLength);
-
-#if ((TRC_CFG_USE_TRACE_ASSERT) == 1)
+traceResult xTraceEntryGetPooledSymbol(const TraceEntryHandle_t xEntryHandle, const char** pszSymbol);
 
 /**
- * @brief Creates trace entry mapped to memory address.
+ * @internal Copies a trace entry to the format that is stored to the host,
+ * where each entry has room for a full length symbol.
  * 
- * @param[in] pvAddress Address.
- * @param[out] pxEntryHandle Pointer to uninitialized trace entry handle.
+ * @param[in] xEntryHandle Pointer to initialized trace entry handle.
+ * @param[out] pxStored Pointer to the stored entry.
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntryCreateWithAddress(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle);
+traceResult xTraceEntryGetStored(const TraceEntryHandle_t xEntryHandle, TraceEntryStored_t* pxStored);
+#endif
 
 /**
- * @brief Sets trace entry state.
+ * @brief Gets trace table entry at index. 
  * 
- * @param[in] xEntryHandle Pointer to initialized trace entry handle.
- * @param[in] uxStateIndex Index of state (< TRC_ENTRY_TABLE_STATE_COUNT).
- * @param[in] uxState State.
+ * @param[in] index Entry index.
+ * @param[out] pxEntryHandle Pointer to uninitialized trace entry handle. 
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntrySetState(const TraceEntryHandle_t xEntryHandle, TraceUnsignedBaseType_t uxStateIndex, TraceUnsignedBaseType_t uxState);
+traceResult xTraceEntryGetAtIndex(uint32_t index, TraceEntryHandle_t* pxEntryHandle);
 
 /**
- * @brief Sets trace entry option(s).
+ * @brief Sets symbol for entry.
  * 
  * @param[in] xEntryHandle Pointer to initialized trace entry handle.
- * @param[in] uiMask Option(s) set mask.
+ * @param[in] szSymbol Pointer to symbol string, set by function
+ * @param[in] uiLength Symbol length
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntrySetOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask);
+traceResult xTraceEntrySetSymbol(const TraceEntryHandle_t xEntryHandle, const char* szSymbol, uint32_t uiLength);
+
+#if ((TRC_CFG_USE_TRACE_ASSERT) == 1)
 
 /**
- * @brief Clears trace entry option(s).
+ * @brief Creates trace entry mapped to memory address.
  * 
- * @param[in] xEntryHandle Pointer to initialized trace entry handle.
- * @param[in] uiMask Options(s) clear mask.
+ * @param[in] pvAddress Address.
+ * @param[out] pxEntryHandle Pointer to uninitialized trace entry handle.
  * 
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-traceResult xTraceEntryClearOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask);
+traceResult xTraceEntryCreateWithAddress(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle);
 
 /**
  * @brief Gets linked address for trace entry.
@@ -285,10 +395,6 @@ traceResult xTraceEntryGetOptions(const TraceEntryHandle_t xEntryHandle, uint32_
 
 #define xTraceEntryCreateWithAddress TRC_ENTRY_CREATE_WITH_ADDRESS
 
-#define xTraceEntrySetState TRC_ENTRY_SET_STATE
-#define xTraceEntrySetOptions TRC_ENTRY_SET_OPTIONS
-#define xTraceEntryClearOptions TRC_ENTRY_CLEAR_OPTIONS
-
 #define xTraceEntryGetAddress TRC_ENTRY_GET_ADDRESS
 #define pvTraceEntryGetAddressReturn TRC_ENTRY_GET_ADDRESS_RETURN
 #define xTraceEntryGetSymbol TRC_ENTRY_GET_SYMBOL
@@ -298,6 +404,52 @@ traceResult xTraceEntryGetOptions(const TraceEntryHandle_t xEntryHandle, uint32_
 
 #endif /* ((TRC_CFG_USE_TRACE_ASSERT) == 1) */
 
+/* Setting states and options must update the change count when the entry table is stored in chunks */
+#if ((TRC_CFG_USE_TRACE_ASSERT) == 1) || ((TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE) > 0)
+
+/**
+ * @brief Sets trace entry state. Increments the change count, since the entry
+ * may already have been stored when the entry table is stored in chunks.
+ * 
+ * @param[in] xEntryHandle Pointer to initialized trace entry handle.
+ * @param[in] uxStateIndex Index of state (< TRC_ENTRY_TABLE_STATE_COUNT).
+ * @param[in] uxState State.
+ * 
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEntrySetState(const TraceEntryHandle_t xEntryHandle, TraceUnsignedBaseType_t uxStateIndex, TraceUnsignedBaseType_t uxState);
+
+/**
+ * @brief Sets trace entry option(s).
+ * 
+ * @param[in] xEntryHandle Pointer to initialized trace entry handle.
+ * @param[in] uiMask Option(s) set mask.
+ * 
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEntrySetOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask);
+
+/**
+ * @brief Clears trace entry option(s).
+ * 
+ * @param[in] xEntryHandle Pointer to initialized trace entry handle.
+ * @param[in] uiMask Options(s) clear mask.
+ * 
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEntryClearOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask);
+
+#else
+
+#define xTraceEntrySetState TRC_ENTRY_SET_STATE
+#define xTraceEntrySetOptions TRC_ENTRY_SET_OPTIONS
+#define xTraceEntryClearOptions TRC_ENTRY_CLEAR_OPTIONS
+
+#endif /* ((TRC_CFG_USE_TRACE_ASSERT) == 1) || ((TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE) > 0) */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -314,6 +466,8 @@ traceResult xTraceEntryGetOptions(const TraceEntryHandle_t xEntryHandle, uint32_
 
 #define xTraceEntryGetCount(_puiCount) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(_puiCount), TRC_SUCCESS)
 
+#define xTraceEntryGetChangeCount(_puiChangeCount) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(_puiChangeCount), TRC_SUCCESS)
+
 #define xTraceEntryGetAtIndex(_index, _pxEntryHandle) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_3((void)(_index), (void)(_pxEntryHandle), TRC_SUCCESS)
 
 #define xTraceEntrySetSymbol(_xEntryHandle, _szSymbol, _uiLength) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_4((void)(_xEntryHandle), (void)(_szSymbol), (void)(_uiLength), TRC_SUCCESS)
@@ -29,22 +29,115 @@ extern "C" {
  * @{
  */
 
+#ifndef TRC_CFG_USE_COMPACT_TIMESTAMPS
+#define TRC_CFG_USE_COMPACT_TIMESTAMPS 0
+#endif
+
+#ifndef TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL
+#define TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL 256
+#endif
+
+#ifndef TRC_CFG_USE_PACKED_EVENT_PARAMETERS
+#define TRC_CFG_USE_PACKED_EVENT_PARAMETERS 0
+#endif
+
+#ifndef TRC_CFG_USE_EVENT_GROUP_FILTER
+#define TRC_CFG_USE_EVENT_GROUP_FILTER 0
+#endif
+
+#ifndef TRC_CFG_INLINE_EVENT_CREATE
+#define TRC_CFG_INLINE_EVENT_CREATE 0
+#endif
+
+#ifndef TRC_CFG_USE_EVENT_COALESCING
+#define TRC_CFG_USE_EVENT_COALESCING 0
+#endif
+
+#ifndef TRC_CFG_EVENT_COALESCING_WINDOW
+#define TRC_CFG_EVENT_COALESCING_WINDOW 16777216
+#endif
+
+#ifndef TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT
+#define TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT 0
+#endif
+
+#ifndef TRC_CFG_USE_EVENT_STATISTICS
+#define TRC_CFG_USE_EVENT_STATISTICS 0
+#endif
+
+#ifndef TRC_CFG_EVENT_STATISTICS_CODES
+#define TRC_CFG_EVENT_STATISTICS_CODES 512
+#endif
+
+#ifndef TRC_CFG_EVENT_STATISTICS_MAX_REPORTS
+#define TRC_CFG_EVENT_STATISTICS_MAX_REPORTS 4
+#endif
+
+#ifndef TRC_CFG_USE_DROPPED_EVENT_MARKERS
+#define TRC_CFG_USE_DROPPED_EVENT_MARKERS 0
+#endif
+
+/**
+ * @brief Number of event groups. Each group holds 16 consecutive event codes.
+ */
+#define TRC_EVENT_GROUP_COUNT 256u
+
+/**
+ * @brief Gets the event group of an event code.
+ */
+#define TRC_EVENT_GROUP(uiEventCode) ((((uint32_t)(uiEventCode)) >> 4) & (TRC_EVENT_GROUP_COUNT - 1u))
+
+/**
+ * @internal Checks if an event group holds events that are needed to interpret
+ * the trace. Where the recorder's own event codes are placed depends on the
+ * kernel port, e.g. 4050-4053 for ThreadX.
+ */
+#define TRC_EVENT_GROUP_IS_REQUIRED(uiGroup) \
+	(((uiGroup) == 0u) || \
+	((uiGroup) == TRC_EVENT_GROUP(PSF_EVENT_TS_SYNC)) || \
+	((uiGroup) == TRC_EVENT_GROUP(PSF_EVENT_REPEAT)) || \
+	((uiGroup) == TRC_EVENT_GROUP(PSF_EVENT_EVENT_STATISTICS)) || \
+	((uiGroup) == TRC_EVENT_GROUP(PSF_EVENT_EVENTS_LOST)))
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+
+#if ((TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL) < 1)
+#error TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL must be at least 1!
+#endif
+
+/**
+ * @internal Compact trace event header. The timestamp is stored as the delta
+ * from the previous event on the same core and the event count is implicit.
+ * Absolute values are provided by timestamp sync events (PSF_EVENT_TS_SYNC).
+ */
+#define TRC_EVENT_HEADER \
+	uint16_t EventID;		/**< */ \
+	uint16_t TSDelta;		/**< */
+
+#else
+
+/**
+ * @internal Trace event header.
+ */
+#define TRC_EVENT_HEADER \
+	uint16_t EventID;		/**< */ \
+	uint16_t EventCount;	/**< */ \
+	uint32_t TS;			/**< */
+
+#endif
+
 /**
  * @internal Trace Event Structure without uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;		/**< */
-	uint16_t EventCount;	/**< */
-	uint32_t TS;			/**< */
+	TRC_EVENT_HEADER
 } TraceEvent0_t;
 
 /**
  * @internal Trace Event Structure with one uTraceUnsignedBaseType_t parameter
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[1];	/**< */
 } TraceEvent1_t;
 
@@ -52,9 +145,7 @@ typedef struct {	/* Aligned */
  * @internal Trace Event Structure with two uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[2];	/**< */
 } TraceEvent2_t;
 
@@ -62,9 +153,7 @@ typedef struct {	/* Aligned */
  * @internal Trace Event Structure with three uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[3];	/**< */
 } TraceEvent3_t;
 
@@ -72,9 +161,7 @@ typedef struct {	/* Aligned */
  * @internal Trace Event Structure with four uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[4];	/**< */
 } TraceEvent4_t;
 
@@ -82,9 +169,7 @@ typedef struct {	/* Aligned */
  * @internal Trace Event Structure with five uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[5];	/**< */
 } TraceEvent5_t;
 
@@ -92,9 +177,7 @@ typedef struct {	/* Aligned */
  * @internal Trace Event Structure with six uTraceUnsignedBaseType_t parameters
  */
 typedef struct {	/* Aligned */
-	uint16_t EventID;						/**< */
-	uint16_t EventCount;					/**< */
-	uint32_t TS;							/**< */
+	TRC_EVENT_HEADER
 	TraceUnsignedBaseType_t uxParams[6];	/**< */
 } TraceEvent6_t;
 
@@ -104,17 +187,72 @@ typedef struct {	/* Aligned */
 typedef struct TraceCoreEventData	/* Aligned */
 {
 	uint32_t eventCounter;										/**< */
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	uint32_t latestTimestamp;									/**< Timestamp that the next delta is relative to */
+	uint32_t syncCountdown;										/**< Events left until the next timestamp sync event */
+	uint32_t timestampDelta;									/**< Delta for the event currently being created */
+#else
 	uint32_t reserved;											/* alignment */
+#endif
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	uint32_t droppedEvents;										/**< Events dropped since the trace session began */
+	uint32_t droppedBytes;										/**< Bytes dropped since the trace session began */
+	uint32_t lostEvents;										/**< Events dropped since the last PSF_EVENT_EVENTS_LOST event */
+	uint32_t lostBytes;											/**< Bytes dropped since the last PSF_EVENT_EVENTS_LOST event */
+	uint32_t lostFirstTimestamp;								/**< Timestamp of the first of the lost events */
+	uint32_t lostLastTimestamp;									/**< Timestamp of the last of the lost events */
+#endif
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+	uint32_t repeatEventCode;									/**< Event code of the current run, TRC_EVENT_REPEAT_NONE if there is none */
+	uint32_t repeatParamCount;									/**< Parameter count of the current run */
+	uint32_t repeatCount;										/**< Repeats counted but not yet written */
+	uint32_t repeatTimestamp;									/**< Timestamp of the last counted repeat */
+	uint32_t repeatStride;										/**< Increase of the last parameter per repeat, 0 or 1 with TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT */
+	uint32_t repeatStartTimestamp;								/**< Timestamp of the event that started the run */
+	TraceUnsignedBaseType_t repeatParams[6];					/**< Parameters of the latest event in the run */
+#endif
 } TraceCoreEventData_t;
 
+/**
+ * @brief Trace event batch. Events added to a batch are written to the trace
+ * buffer with a single allocation and commit.
+ */
+typedef struct TraceEventBatch	/* Aligned */
+{
+	uint32_t uiSize;																	/**< Bytes used in auxData */
+	uint32_t uiCount;																	/**< Events in auxData */
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	uint32_t uiLostSize;																/**< Bytes of a lost events marker at the start of auxData, 0 if there is none */
+	uint32_t reserved;																	/**< Keeps auxData aligned */
+#endif
+	TraceUnsignedBaseType_t auxData[TRC_MAX_BLOB_SIZE / sizeof(TraceUnsignedBaseType_t)];	/**< The batched events */
+} TraceEventBatch_t;
+
+/**
+ * @internal Trace Event Statistics Structure
+ */
+typedef struct TraceEventStatistics	/* Aligned */
+{
+	uint32_t uiCount;											/**< Events written, including coalesced repeats */
+	uint32_t uiBytes;											/**< Bytes written */
+} TraceEventStatistics_t;
+
 /** 
  * @internal Trace Event Data Table Structure.
  */
 typedef struct TraceEventDataTable	/* Aligned */
 {
 	TraceCoreEventData_t coreEventData[TRC_CFG_CORE_COUNT]; /**< Holds data about current event for each core/isr depth */
+#if (TRC_CFG_USE_EVENT_GROUP_FILTER == 1)
+	uint32_t uiGroupFilter[TRC_EVENT_GROUP_COUNT / 32u];	/**< One bit per event group, set if enabled */
+#endif
+#if (TRC_CFG_USE_EVENT_STATISTICS == 1)
+	TraceEventStatistics_t xStatistics[(TRC_CFG_EVENT_STATISTICS_CODES) + 1];	/**< Indexed by event code, the last entry holds all higher event codes */
+#endif
 } TraceEventDataTable_t;
 
+extern TraceEventDataTable_t* pxTraceEventDataTable;
+
 /**
  * @internal Initialize event trace system.
  * 
@@ -126,6 +264,175 @@ typedef struct TraceEventDataTable	/* Aligned */
  */
 traceResult xTraceEventInitialize(TraceEventDataTable_t* pxBuffer);
 
+#if (TRC_CFG_USE_EVENT_GROUP_FILTER == 1)
+
+/**
+ * @brief Enables an event group. All event groups are enabled by default.
+ *
+ * @param[in] uiGroup Event group, see TRC_EVENT_GROUP().
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventGroupEnable(uint32_t uiGroup);
+
+/**
+ * @brief Disables an event group. Events in the group are then discarded
+ * before any buffer space is allocated. Group 0 holds the events needed to
+ * interpret the trace and can't be disabled, and neither can the groups of the
+ * recorder's own timestamp sync, repeat, statistics and lost events.
+ *
+ * @param[in] uiGroup Event group, see TRC_EVENT_GROUP().
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventGroupDisable(uint32_t uiGroup);
+
+/**
+ * @internal Checks if the event group of an event code is enabled.
+ */
+#define xTraceEventGroupIsEnabled(uiEventCode) ((pxTraceEventDataTable->uiGroupFilter[TRC_EVENT_GROUP(uiEventCode) >> 5] & (1UL << (TRC_EVENT_GROUP(uiEventCode) & 31u))) != 0u)
+
+#else
+
+#define xTraceEventGroupEnable(uiGroup) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(uiGroup), TRC_SUCCESS)
+#define xTraceEventGroupDisable(uiGroup) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(uiGroup), TRC_SUCCESS)
+#define xTraceEventGroupIsEnabled(uiEventCode) (1)
+
+#endif
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+
+/**
+ * @internal Makes the next event on every core start with a timestamp sync
+ * event. Used when a new trace session begins.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventSyncTimestamps(void);
+
+#else
+
+#define xTraceEventSyncTimestamps() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#endif
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+
+/**
+ * @internal Event code marking that a core has no run of repeated events.
+ */
+#define TRC_EVENT_REPEAT_NONE 0xFFFFFFFFUL
+
+/**
+ * @brief Writes the repeat counts of every core, if any, and ends their runs
+ * of repeated events. Called periodically by xTraceTzCtrl.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventFlushRepeats(void);
+
+/**
+ * @internal Discards the runs of repeated events on every core. Used when a
+ * new trace session begins.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventResetRepeats(void);
+
+#else
+
+#define xTraceEventFlushRepeats() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+#define xTraceEventResetRepeats() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#endif
+
+#if (TRC_CFG_USE_EVENT_STATISTICS == 1)
+
+/**
+ * @internal Statistics table index of an event code.
+ */
+#define TRC_EVENT_STATISTICS_INDEX(uiEventCode) ((((uint32_t)(uiEventCode) & 0xFFFUL) < (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES)) ? ((uint32_t)(uiEventCode) & 0xFFFUL) : (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES))
+
+/**
+ * @brief Retrieves the number of events and bytes written with an event code
+ * since the trace session began. Event codes from
+ * TRC_CFG_EVENT_STATISTICS_CODES and up share one entry. Repeats coalesced by
+ * TRC_CFG_USE_EVENT_COALESCING are included in the event count but add no
+ * bytes.
+ *
+ * @param[in] uiEventCode Event code
+ * @param[out] puiCount Events written
+ * @param[out] puiBytes Bytes written
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventStatisticsGet(uint32_t uiEventCode, uint32_t* puiCount, uint32_t* puiBytes);
+
+/**
+ * @internal Clears the statistics. Used when a new trace session begins.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventStatisticsReset(void);
+
+/**
+ * @internal Reports the statistics of up to TRC_CFG_EVENT_STATISTICS_MAX_REPORTS
+ * event codes, continuing where the previous call stopped. Called periodically
+ * by xTraceTzCtrl.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventStatisticsReport(void);
+
+#else
+
+#define xTraceEventStatisticsGet(uiEventCode, puiCount, puiBytes) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_4((void)(uiEventCode), (void)(puiCount), (void)(puiBytes), TRC_FAIL)
+#define xTraceEventStatisticsReset() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+#define xTraceEventStatisticsReport() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#endif
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+
+/**
+ * @brief Retrieves the number of events and bytes dropped on a core since the
+ * trace session began. Events are dropped when the trace buffer is full and
+ * TRC_EVENT_BUFFER_OPTION_SKIP is used. Can be used to size the trace buffer
+ * from the actual loss.
+ *
+ * @param[in] uiCoreId Core
+ * @param[out] puiEvents Events dropped
+ * @param[out] puiBytes Bytes dropped
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventDroppedGet(uint32_t uiCoreId, uint32_t* puiEvents, uint32_t* puiBytes);
+
+/**
+ * @internal Clears the dropped event counts. Used when a new trace session
+ * begins.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventDroppedReset(void);
+
+#else
+
+#define xTraceEventDroppedGet(uiCoreId, puiEvents, puiBytes) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_4((void)(uiCoreId), (void)(puiEvents), (void)(puiBytes), TRC_FAIL)
+#define xTraceEventDroppedReset() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#endif
+
 /**
  * Create a raw data event (i.e. not event code provided)
  * @param pxSource The source buffer which should be copied
@@ -345,6 +652,63 @@ traceResult xTraceEventCreateData5(uint32_t uiEventCode, TraceUnsignedBaseType_t
  */
 traceResult xTraceEventCreateData6(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4, TraceUnsignedBaseType_t uxParam5, TraceUnsignedBaseType_t uxParam6, const TraceUnsignedBaseType_t* const puxData, TraceUnsignedBaseType_t uxSize);
 
+/**
+ * @brief Begins a batch of events. Events that are created back to back can be
+ * added to a batch to share one buffer allocation and commit.
+ *
+ * The trace critical section must be held from xTraceEventBatchBegin(...) to
+ * xTraceEventBatchCommit(...), since the events are timestamped when added.
+ * A pending lost events marker and the repeat count of a coalesced run, if
+ * any, are added first so they share the allocation with the batched events.
+ *
+ * @param[out] pxBatch Pointer to uninitialized batch, typically on the stack.
+ *
+ * @retval TRC_FAIL Failure, the recorder isn't enabled
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBatchBegin(TraceEventBatch_t* pxBatch);
+
+/**
+ * @brief Adds an event with up to 6 parameters to a batch. If the batch is
+ * full, the events already added are committed first.
+ *
+ * @param[in] pxBatch Pointer to batch.
+ * @param[in] uiEventCode Event code.
+ * @param[in] puxParams Pointer to parameters.
+ * @param[in] uiParamCount Number of parameters.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBatchAdd(TraceEventBatch_t* pxBatch, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount);
+
+/**
+ * @brief Adds an event with up to 6 parameters and a payload to a batch. The
+ * payload is truncated if too big, like for xTraceEventCreateData0..6.
+ *
+ * @param[in] pxBatch Pointer to batch.
+ * @param[in] uiEventCode Event code.
+ * @param[in] puxParams Pointer to parameters.
+ * @param[in] uiParamCount Number of parameters.
+ * @param[in] pvData Pointer to payload buffer.
+ * @param[in] uiDataSize Size of the payload buffer.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBatchAddData(TraceEventBatch_t* pxBatch, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount, const void* const pvData, uint32_t uiDataSize);
+
+/**
+ * @brief Writes the events of a batch to the trace buffer. The batch can be
+ * reused afterwards.
+ *
+ * @param[in] pxBatch Pointer to batch.
+ *
+ * @retval TRC_FAIL Failure, the events were dropped
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBatchCommit(TraceEventBatch_t* pxBatch);
+
 /**
  * @brief Gets trace event size.
  * 
@@ -358,12 +722,19 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
 
 /* Helper macros */
 
+#if (TRC_CFG_INLINE_EVENT_CREATE == 1)
+/* The helper macros below use the inlined versions in trcEventInline.h */
+#define TRC_EVENT_CREATE_FUNCTION(n) prvTraceEventCreateInline##n
+#else
+#define TRC_EVENT_CREATE_FUNCTION(n) xTraceEventCreate##n
+#endif
+
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts no parameters.
  * 
  * @param[in] _eventID Event id
  */
-#define prvTraceEventCreate0(_eventID) xTraceEventCreate0(_eventID)
+#define prvTraceEventCreate0(_eventID) TRC_EVENT_CREATE_FUNCTION(0)(_eventID)
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 1 parameters.
@@ -371,7 +742,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _eventID Event id
  * @param[in] _param Param
  */
-#define prvTraceEventCreate1(_eventID, _param) xTraceEventCreate1(_eventID, (TraceUnsignedBaseType_t)(_param))
+#define prvTraceEventCreate1(_eventID, _param) TRC_EVENT_CREATE_FUNCTION(1)(_eventID, (TraceUnsignedBaseType_t)(_param))
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 2 parameters.
@@ -380,7 +751,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _param1 Param 1
  * @param[in] _param2 Param 2
  */
-#define prvTraceEventCreate2(_eventID, _param1, _param2)  xTraceEventCreate2(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2))
+#define prvTraceEventCreate2(_eventID, _param1, _param2)  TRC_EVENT_CREATE_FUNCTION(2)(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2))
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 3 parameters.
@@ -390,7 +761,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _param2 Param 2
  * @param[in] _param3 Param 3
  */
-#define prvTraceEventCreate3(_eventID, _param1, _param2, _param3) xTraceEventCreate3(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3))
+#define prvTraceEventCreate3(_eventID, _param1, _param2, _param3) TRC_EVENT_CREATE_FUNCTION(3)(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3))
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 4 parameters.
@@ -401,7 +772,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _param3 Param 3
  * @param[in] _param4 Param 4
  */
-#define prvTraceEventCreate4(_eventID, _param1, _param2, _param3, _param4) xTraceEventCreate4(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4))
+#define prvTraceEventCreate4(_eventID, _param1, _param2, _param3, _param4) TRC_EVENT_CREATE_FUNCTION(4)(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4))
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 5 parameters.
@@ -413,7 +784,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _param4 Param 4
  * @param[in] _param5 Param 5
  */
-#define prvTraceEventCreate5(_eventID, _param1, _param2, _param3, _param4, _param5) xTraceEventCreate5(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4), (TraceUnsignedBaseType_t)(_param5))
+#define prvTraceEventCreate5(_eventID, _param1, _param2, _param3, _param4, _param5) TRC_EVENT_CREATE_FUNCTION(5)(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4), (TraceUnsignedBaseType_t)(_param5))
 
 /**
  * @brief Helper macro that handles type casting for all parameters. Accepts 6 parameters.
@@ -426,7 +797,7 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize);
  * @param[in] _param5 Param 5
  * @param[in] _param6 Param 6
  */
-#define prvTraceEventCreate6(_eventID, _param1, _param2, _param3, _param4, _param5, _param6) xTraceEventCreate6(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4), (TraceUnsignedBaseType_t)(_param5), (TraceUnsignedBaseType_t)(_param6))
+#define prvTraceEventCreate6(_eventID, _param1, _param2, _param3, _param4, _param5, _param6) TRC_EVENT_CREATE_FUNCTION(6)(_eventID, (TraceUnsignedBaseType_t)(_param1), (TraceUnsignedBaseType_t)(_param2), (TraceUnsignedBaseType_t)(_param3), (TraceUnsignedBaseType_t)(_param4), (TraceUnsignedBaseType_t)(_param5), (TraceUnsignedBaseType_t)(_param6))
 
 /** @} */
 
@@ -41,8 +41,56 @@ extern "C" {
  */
 #define TRC_EVENT_BUFFER_OPTION_OVERWRITE	(1U)
 
+/* Unless specified in trcConfig.h events are allocated and committed inside one critical section */
+#ifndef TRC_CFG_USE_EVENT_BUFFER_RESERVATION
+#define TRC_CFG_USE_EVENT_BUFFER_RESERVATION 0
+#endif
+
+/* Unless specified in trcConfig.h event buffers can have any size */
+#ifndef TRC_CFG_EVENT_BUFFER_POW2_SIZE
+#define TRC_CFG_EVENT_BUFFER_POW2_SIZE 0
+#endif
+
+/* Unless specified in trcConfig.h overwrite mode evicts one event at a time */
+#ifndef TRC_CFG_EVENT_BUFFER_BLOCK_SIZE
+#define TRC_CFG_EVENT_BUFFER_BLOCK_SIZE 0
+#endif
+
+#if ((TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) != 0) && ((((TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) & ((TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) - 1)) != 0) || ((TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) < 4))
+#error TRC_CFG_EVENT_BUFFER_BLOCK_SIZE must be zero or a power of two of at least 4!
+#endif
+
+/**
+ * @internal Macro that returns the size of the block index for uiDataSize bytes of event data.
+ */
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+#define TRC_EVENT_BUFFER_BLOCK_INDEX_SIZE(uiDataSize) (((uiDataSize) / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE)) * (uint32_t)sizeof(uint32_t))
+#else
+#define TRC_EVENT_BUFFER_BLOCK_INDEX_SIZE(uiDataSize) (0u)
+#endif
+
+/**
+ * @internal Macro that wraps an index into a trace event buffer of size uiBufferSize.
+ */
+#if (TRC_CFG_EVENT_BUFFER_POW2_SIZE == 1)
+#define TRC_EVENT_BUFFER_WRAP(uiIndex, uiBufferSize) ((uiIndex) & ((uiBufferSize) - 1u))
+#else
+#define TRC_EVENT_BUFFER_WRAP(uiIndex, uiBufferSize) ((uiIndex) % (uiBufferSize))
+#endif
+
 /**
  * @brief Trace Event Buffer Structure
+ *
+ * With TRC_EVENT_BUFFER_OPTION_SKIP the buffer is a single-producer,
+ * single-consumer ring. Events are written on the core owning the buffer,
+ * which publishes uiHead (and uiSlack) with release ordering, while the
+ * transfer functions may drain it from any core and publish uiTail the same
+ * way. The core owning the buffer doesn't need to be stopped for a transfer.
+ * In TRC_EVENT_BUFFER_OPTION_OVERWRITE mode the producer also moves uiTail, so
+ * the buffer must not be transferred while events are written.
+ *
+ * The default memory barrier can be replaced by defining TRC_CFG_MEMORY_BARRIER()
+ * in trcConfig.h.
  */
 typedef struct TraceEventBuffer	/* Aligned */
 {
@@ -50,12 +98,12 @@ typedef struct TraceEventBuffer	/* Aligned */
 	uint32_t uiTail;				/**< Tail index of buffer */
 	uint32_t uiSize;				/**< Buffer size */
 	uint32_t uiOptions;				/**< Options (skip/overwrite when full) */
-	uint32_t uiDroppedEvents;		/**< Nr of dropped events */
+	uint32_t uiDroppedEvents;		/**< Nr of events dropped since the buffer was cleared (skip mode) */
 	uint32_t uiFree;				/**< Nr of free bytes */
 	uint32_t uiSlack;				/**< */
-	uint32_t uiNextHead;			/**< */
+	uint32_t uiNextHead;			/**< Head after the last allocation, the reservation head in reservation mode */
 	uint32_t uiTimerWraparounds;	/**< Nr of timer wraparounds */
-	uint32_t uiReserved;			/**< Reserved */
+	uint32_t uiReserveDepth;		/**< Nr of uncommitted reservations (reservation mode) */
 	uint8_t* puiBuffer;				/**< Trace Event Buffer: may be NULL */
 } TraceEventBuffer_t;
 
@@ -69,6 +117,13 @@ typedef struct TraceEventBuffer	/* Aligned */
  * old data, the alternatives are TRC_EVENT_BUFFER_OPTION_SKIP and
  * TRC_EVENT_BUFFER_OPTION_OVERWRITE (mutual exclusive).
  *
+ * If TRC_CFG_EVENT_BUFFER_BLOCK_SIZE is set, an overwrite buffer keeps its block
+ * index after the event data and the event data size is rounded down to a whole
+ * number of blocks.
+ *
+ * If TRC_CFG_EVENT_BUFFER_POW2_SIZE is enabled the event data size must be a
+ * power of two.
+ *
  * @param[out] pxTraceEventBuffer Pointer to uninitialized trace event buffer.
  * @param[in] uiOptions Trace event buffer options.
  * @param[in] puiBuffer Pointer to buffer that will be used by the trace event buffer.
@@ -95,6 +150,14 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 /**
  * @brief Commits the last allocated block to the event buffer.
  *
+ * With TRC_CFG_USE_EVENT_BUFFER_RESERVATION enabled only the allocation must be
+ * made with interrupts masked, the commit takes its own short critical section.
+ * uiHead is only advanced when the last outstanding reservation is committed,
+ * so transfers never include an allocation that is still being filled. A
+ * context that is preempted between allocation and commit holds back every
+ * event allocated after it, and overwrite buffers drop events instead of
+ * evicting while a reservation is outstanding.
+ *
  * @param[in] pxTraceEventBuffer Pointer to initialized trace event buffer.
  *
  * @retval TRC_FAIL Failure
@@ -156,6 +219,33 @@ traceResult xTraceEventBufferTransferAll(TraceEventBuffer_t* pxTraceEventBuffer,
  */
 traceResult xTraceEventBufferTransferChunk(TraceEventBuffer_t* pxTraceEventBuffer, uint32_t uiChunkSize, uint32_t uiCoreId, int32_t* piBytesWritten);
 
+/**
+ * @brief Gets the oldest data in the trace event buffer without transferring
+ * it. The data stays in the buffer until released with xTraceEventBufferRelease.
+ *
+ * Only the data up to the end of the buffer is returned if it wraps. The rest
+ * is returned by the next call, once the first part has been released.
+ *
+ * @param[in] pxTraceEventBuffer Pointer to initialized trace event buffer.
+ * @param[out] ppvData Pointer to the oldest data.
+ * @param[out] puiSize Bytes of contiguous data, 0 if the buffer is empty.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBufferPeek(TraceEventBuffer_t* pxTraceEventBuffer, void** ppvData, uint32_t* puiSize);
+
+/**
+ * @brief Releases data returned by xTraceEventBufferPeek, so the space can be
+ * reused.
+ *
+ * @param[in] pxTraceEventBuffer Pointer to initialized trace event buffer.
+ * @param[in] uiSize Bytes to release, at most the size given by the peek.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceEventBufferRelease(TraceEventBuffer_t* pxTraceEventBuffer, uint32_t uiSize);
 
 /**
  * @brief Clears all data from event buffer.
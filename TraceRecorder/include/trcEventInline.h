@@ -0,0 +1,408 @@
+/*
+* Percepio Trace Recorder for Tracealyzer v4.11.1
+* Copyright 2025 Percepio AB
+* www.percepio.com
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+/**
+ * @file 
+ * 
+ * @brief Internal event write macros and the inlined event create functions.
+ *
+ * This header is included at the end of trcRecorder.h since the write path
+ * depends on the streamport, internal buffer, timestamp and recorder state
+ * declarations.
+ */
+
+#ifndef TRC_EVENT_INLINE_H
+#define TRC_EVENT_INLINE_H
+
+#if (TRC_USE_TRACEALYZER_RECORDER == 1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef TRC_USE_CUSTOM_STREAMPORT_ALLOCATION
+
+#if (TRC_USE_INTERNAL_BUFFER == 1)
+#error The internal buffer should not be enabled while custom streamport allocation is enabled!
+#endif
+
+/* Custom streamport allocation/commit functions should be used */
+#define xTraceEventAllocate(_uiSize, _ppvData) xTraceStreamPortAllocate(_uiSize, _ppvData)
+#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceStreamPortCommit(_pvData, _uiSize, _piBytesCommitted)
+
+#elif (TRC_USE_INTERNAL_BUFFER == 1)
+
+/* Using the internal event buffer */
+#define xTraceEventAllocate(_uiSize, _ppvData) xTraceInternalEventBufferAlloc(_uiSize, _ppvData)
+#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceInternalEventBufferAllocCommit(_pvData, _uiSize, _piBytesCommitted)
+
+#else
+
+/* Default implementation that will be used if the streamport doesn't implement a custom allocation/commit method and the internal buffer isn't used */
+#define xTraceEventAllocate(_uiSize, _ppvData) ((void)(_uiSize), xTraceStaticBufferGet(_ppvData))
+#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceStreamPortWriteData(_pvData, _uiSize, TRC_CFG_GET_CURRENT_CORE(), _piBytesCommitted)
+
+#endif
+
+#if ((TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1) && (defined(TRC_USE_CUSTOM_STREAMPORT_ALLOCATION) || (TRC_USE_INTERNAL_BUFFER == 1)))
+
+/* Only the reservation needs interrupts masked, the event is filled and committed after leaving the critical section */
+#define TRACE_EVENT_RESERVATION_END() TRACE_EXIT_CRITICAL_SECTION()
+#define TRACE_EVENT_COMMIT_END()
+
+#else
+
+/* The whole allocate, fill and commit sequence is made inside the critical section */
+#define TRACE_EVENT_RESERVATION_END()
+#define TRACE_EVENT_COMMIT_END() TRACE_EXIT_CRITICAL_SECTION()
+
+#endif
+
+/**
+ * @internal Macro helper for setting trace event parameter count.
+ */
+#define TRC_EVENT_SET_PARAM_COUNT(id, n) ((uint16_t)(((uint16_t)(id)) | ((((uint16_t)(n)) & 0xF) << 12)))
+
+/**
+ * @internal Macro helper for getting trace event parameter count.
+ */
+#define TRC_EVENT_GET_PARAM_COUNT(id) (((id) >> 12u) & 0xFU)
+
+#if (TRC_CFG_CORE_COUNT > 1)
+#define TRC_EVENT_SET_EVENT_COUNT(c)  ((uint16_t)(((TRC_CFG_GET_CURRENT_CORE() & 0xF) << 12) | ((uint16_t)(c) & 0xFFF)))
+#else
+#define TRC_EVENT_SET_EVENT_COUNT(c) ((uint16_t)(c))
+#endif
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+
+#if (TRC_CFG_CORE_COUNT > 1)
+/* The top nibble holds the core id, like the event count in the full header */
+#define TRC_EVENT_TS_DELTA_MAX 0xFFFUL
+#define TRC_EVENT_SET_TS_DELTA(d)  ((uint16_t)(((TRC_CFG_GET_CURRENT_CORE() & 0xF) << 12) | ((uint16_t)(d) & 0xFFF)))
+#else
+#define TRC_EVENT_TS_DELTA_MAX 0xFFFFUL
+#define TRC_EVENT_SET_TS_DELTA(d) ((uint16_t)(d))
+#endif
+
+#endif
+
+/* Counts an event that didn't fit in the trace buffer, called from within the critical section */
+#define TRACE_EVENT_DROPPED(size) prvTraceEventDropped(1u, (uint32_t)(size))
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+
+/* Events lost on this core are reported before the next event that fits */
+#define TRACE_EVENT_WRITE_LOST() ((pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].lostEvents == 0u) ? TRC_SUCCESS : prvTraceEventWriteLost())
+
+#else
+
+#define TRACE_EVENT_WRITE_LOST() TRC_SUCCESS
+
+#endif
+
+/**
+ * @internal Macro helper for setting base event data.
+ */
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+
+/* The timestamp delta was taken by prvTraceEventSyncTimestamp() before allocating, the event count is implicit */
+#define SET_BASE_EVENT_DATA(pxEvent, eventId, paramCount, eventCount) \
+	( \
+		(pxEvent)->EventID = TRC_EVENT_SET_PARAM_COUNT(eventId, paramCount), \
+		(pxEvent)->TSDelta = TRC_EVENT_SET_TS_DELTA(pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].timestampDelta), \
+		(void)(eventCount) \
+	)
+
+/* A timestamp sync event may have to be written before the event */
+#define TRACE_EVENT_ALLOCATE(size, ppvData) (((TRACE_EVENT_WRITE_LOST() == TRC_FAIL) || (prvTraceEventSyncTimestamp() == TRC_FAIL)) ? TRC_FAIL : xTraceEventAllocate(size, ppvData))
+
+/* The next event must be preceded by a sync event, since the implicit event count can't be followed */
+#define TRACE_EVENT_SYNC_REQUIRED() pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].syncCountdown = 0u
+
+#else
+
+#define SET_BASE_EVENT_DATA(pxEvent, eventId, paramCount, eventCount) \
+	( \
+		(pxEvent)->EventID = TRC_EVENT_SET_PARAM_COUNT(eventId, paramCount), \
+		(pxEvent)->EventCount = TRC_EVENT_SET_EVENT_COUNT(eventCount), \
+		(void)xTraceTimestampGet(&(pxEvent)->TS) \
+	)
+
+#define TRACE_EVENT_ALLOCATE(size, ppvData) ((TRACE_EVENT_WRITE_LOST() == TRC_FAIL) ? TRC_FAIL : xTraceEventAllocate(size, ppvData))
+
+#define TRACE_EVENT_SYNC_REQUIRED()
+
+#endif
+
+#if (TRC_CFG_USE_EVENT_STATISTICS == 1)
+
+/* Counts a written event, called from within the critical section */
+#define TRACE_EVENT_STATISTICS_ADD(eventCode, size) \
+	( \
+		pxTraceEventDataTable->xStatistics[TRC_EVENT_STATISTICS_INDEX(eventCode)].uiCount++, \
+		pxTraceEventDataTable->xStatistics[TRC_EVENT_STATISTICS_INDEX(eventCode)].uiBytes += (uint32_t)(size) \
+	)
+
+#else
+
+#define TRACE_EVENT_STATISTICS_ADD(eventCode, size)
+
+#endif
+
+#define TRACE_EVENT_BEGIN_OFFLINE(size) 														\
+	TRACE_ENTER_CRITICAL_SECTION();              										\
+	pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter++; 	\
+	if (TRACE_EVENT_ALLOCATE((uint32_t)(size), (void**)&pxEventData) == TRC_FAIL)  /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/ \
+	{                                            										\
+		TRACE_EVENT_DROPPED(size);             											\
+		TRACE_EXIT_CRITICAL_SECTION();              									\
+		return TRC_FAIL; 																\
+	} 																					\
+	TRACE_EVENT_STATISTICS_ADD(uiEventCode, size);										\
+	SET_BASE_EVENT_DATA(pxEventData, uiEventCode, ((size) - sizeof(TraceEvent0_t)) / sizeof(TraceUnsignedBaseType_t), pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter); /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/ \
+	TRACE_EVENT_RESERVATION_END();
+
+#define TRACE_EVENT_BEGIN(size) 														\
+	/* We need to check this */                  										\
+	if (!xTraceIsRecorderEnabled())              										\
+	{ 																					\
+		return TRC_FAIL;                            									\
+	} 																					\
+	/* Filtered events are discarded before allocating */								\
+	if (!xTraceEventGroupIsEnabled(uiEventCode))										\
+	{ 																					\
+		return TRC_SUCCESS;                            									\
+	} 																					\
+	TRACE_EVENT_BEGIN_OFFLINE(size)
+
+
+#define TRACE_EVENT_END(size) 															\
+	(void)xTraceEventCommit(pxEventData, (uint32_t)(size), &iBytesCommitted); 			\
+	TRACE_EVENT_COMMIT_END(); 															\
+	/* We need to use iBytesCommitted for the above call but do not use the value */	\
+	/* Remove potential warnings */ 													\
+	(void)iBytesCommitted;
+
+#define TRACE_EVENT_ADD_1(__p1)									\
+	pxEventData->uxParams[0] = __p1;
+
+#define TRACE_EVENT_ADD_2(__p1, __p2)							\
+	TRACE_EVENT_ADD_1(__p1)										\
+	pxEventData->uxParams[1] = __p2;
+
+#define TRACE_EVENT_ADD_3(__p1, __p2, __p3)						\
+	TRACE_EVENT_ADD_2(__p1, __p2)								\
+	pxEventData->uxParams[2] = __p3;
+
+#define TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)				\
+	TRACE_EVENT_ADD_3(__p1, __p2, __p3)							\
+	pxEventData->uxParams[3] = __p4;
+
+#define TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)			\
+	TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)					\
+	pxEventData->uxParams[4] = __p5;
+
+#define TRACE_EVENT_ADD_6(__p1, __p2, __p3, __p4, __p5, __p6)	\
+	TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)				\
+	pxEventData->uxParams[5] = __p6;
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+/**
+ * @internal Takes the timestamp for the next event and writes a timestamp sync event first if needed.
+ * Must be called from within the critical section.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult prvTraceEventSyncTimestamp(void);
+#endif
+
+/**
+ * @internal Counts events that didn't fit in the trace buffer on this core.
+ * Must be called from within the critical section.
+ *
+ * @param[in] uiEvents Events dropped
+ * @param[in] uiBytes Bytes dropped
+ */
+void prvTraceEventDropped(uint32_t uiEvents, uint32_t uiBytes);
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+/**
+ * @internal Writes a PSF_EVENT_EVENTS_LOST event for the events lost on this
+ * core since the previous one. Must be called from within the critical section.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult prvTraceEventWriteLost(void);
+#endif
+
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+/**
+ * @internal Creates an event with varint packed parameters.
+ *
+ * @param[in] uiEventCode Event code
+ * @param[in] puxParams Parameters
+ * @param[in] uiParamCount Parameter count, 0 to 6
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult prvTraceEventCreatePacked(uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount);
+#endif
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+/**
+ * @internal Creates an event, or counts it if it repeats the previous event on this core.
+ *
+ * @param[in] uiEventCode Event code
+ * @param[in] puxParams Parameters
+ * @param[in] uiParamCount Parameter count, 0 to 6
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult prvTraceEventCreateCoalesced(uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount);
+#endif
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+/* Fixed-parameter events are passed as an array to the coalescing stage */
+#define TRC_EVENT_CREATE_FROM_ARRAY prvTraceEventCreateCoalesced
+#elif (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+/* Fixed-parameter events are passed as an array to be packed */
+#define TRC_EVENT_CREATE_FROM_ARRAY prvTraceEventCreatePacked
+#endif
+
+#if (TRC_CFG_INLINE_EVENT_CREATE == 1)
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1) || (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+#error TRC_CFG_INLINE_EVENT_CREATE must not be combined with TRC_CFG_USE_EVENT_COALESCING or TRC_CFG_USE_PACKED_EVENT_PARAMETERS!
+#endif
+
+/* Inlined versions of xTraceEventCreate0-6, used by the prvTraceEventCreate0-6 macros. The
+ * backend is selected at compile time so constant event codes and sizes fold at the call site. */
+
+static inline traceResult prvTraceEventCreateInline0(uint32_t uiEventCode)
+{
+	TraceEvent0_t* pxEventData = (TraceEvent0_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent0_t));
+	TRACE_EVENT_END(sizeof(TraceEvent0_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline1(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1)
+{
+	TraceEvent1_t* pxEventData = (TraceEvent1_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent1_t));
+
+	TRACE_EVENT_ADD_1(uxParam1);
+
+	TRACE_EVENT_END(sizeof(TraceEvent1_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline2(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2)
+{
+	TraceEvent2_t* pxEventData = (TraceEvent2_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent2_t));
+
+	TRACE_EVENT_ADD_2(uxParam1, uxParam2);
+
+	TRACE_EVENT_END(sizeof(TraceEvent2_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline3(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3)
+{
+	TraceEvent3_t* pxEventData = (TraceEvent3_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent3_t));
+
+	TRACE_EVENT_ADD_3(uxParam1, uxParam2, uxParam3);
+
+	TRACE_EVENT_END(sizeof(TraceEvent3_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline4(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4)
+{
+	TraceEvent4_t* pxEventData = (TraceEvent4_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent4_t));
+
+	TRACE_EVENT_ADD_4(uxParam1, uxParam2, uxParam3, uxParam4);
+
+	TRACE_EVENT_END(sizeof(TraceEvent4_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline5(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4, TraceUnsignedBaseType_t uxParam5)
+{
+	TraceEvent5_t* pxEventData = (TraceEvent5_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent5_t));
+
+	TRACE_EVENT_ADD_5(uxParam1, uxParam2, uxParam3, uxParam4, uxParam5);
+
+	TRACE_EVENT_END(sizeof(TraceEvent5_t));
+
+	return TRC_SUCCESS;
+}
+
+static inline traceResult prvTraceEventCreateInline6(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4, TraceUnsignedBaseType_t uxParam5, TraceUnsignedBaseType_t uxParam6)
+{
+	TraceEvent6_t* pxEventData = (TraceEvent6_t*)0;
+	int32_t iBytesCommitted = 0;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_EVENT_BEGIN(sizeof(TraceEvent6_t));
+
+	TRACE_EVENT_ADD_6(uxParam1, uxParam2, uxParam3, uxParam4, uxParam5, uxParam6);
+
+	TRACE_EVENT_END(sizeof(TraceEvent6_t));
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* (TRC_USE_TRACEALYZER_RECORDER == 1) */
+
+#endif /* TRC_EVENT_INLINE_H */
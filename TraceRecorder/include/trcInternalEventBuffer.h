@@ -25,6 +25,30 @@
 #define TRC_USE_INTERNAL_BUFFER 1
 #endif
 
+/* Unless specified in trcConfig.h the TzCtrl task only runs periodically */
+#ifndef TRC_CFG_CTRL_TASK_WAKEUP_LEVEL
+#define TRC_CFG_CTRL_TASK_WAKEUP_LEVEL 0
+#endif
+
+#ifndef TRC_CFG_CTRL_TASK_IDLE_DELAY
+#define TRC_CFG_CTRL_TASK_IDLE_DELAY (TRC_CFG_CTRL_TASK_DELAY)
+#endif
+
+/* Defined as 1 by kernel ports that implement xTraceKernelPortNotifyCtrlTask() */
+#ifndef TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY
+#define TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY 0
+#endif
+
+/**
+ * @internal Set to 1 if the TzCtrl task is woken when the internal buffer
+ * of the current core fills up to TRC_CFG_CTRL_TASK_WAKEUP_LEVEL percent.
+ */
+#if (TRC_USE_INTERNAL_BUFFER == 1) && ((TRC_CFG_CTRL_TASK_WAKEUP_LEVEL) > 0) && (TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY == 1)
+#define TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP 1
+#else
+#define TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP 0
+#endif
+
 #if (TRC_USE_INTERNAL_BUFFER == 1)
 
 /* Aligned */
@@ -125,8 +149,16 @@ traceResult xTraceInternalEventBufferAllocCommit(void *pvData, uint32_t uiSize,
  */
 traceResult xTraceInternalEventBufferPush(void *pvData, uint32_t uiSize, int32_t *piBytesWritten);
 
-#if (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_ALL)
+#if defined(TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT) && (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED)
+#error Asynchronous stream port writes cannot be combined with TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED!
+#endif
+
+#if defined(TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT)
+#define xTraceInternalEventBufferTransfer xTraceInternalEventBufferTransferAsync
+#elif (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_ALL)
 #define xTraceInternalEventBufferTransfer xTraceInternalEventBufferTransferAll
+#elif (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED)
+#define xTraceInternalEventBufferTransfer xTraceInternalEventBufferTransferMerged
 #else
 #define xTraceInternalEventBufferTransfer xTraceInternalEventBufferTransferChunk
 #endif
@@ -164,6 +196,91 @@ traceResult xTraceInternalEventBufferTransferAll(void);
  */
 traceResult xTraceInternalEventBufferTransferChunk(void);
 
+#if (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED)
+
+/**
+ * @brief Transfer internal trace event buffer data through streamport,
+ * interleaving the cores by event timestamp.
+ *
+ * Intended for stream ports that send all cores over a single stream (i.e.
+ * without TRC_STREAM_PORT_MULTISTREAM_SUPPORT), where the per-core chunks of
+ * xTraceInternalEventBufferTransferChunk arrive out of order. Chunks of up to
+ * TRC_INTERNAL_BUFFER_CHUNK_SIZE bytes are merged by
+ * xTraceMultiCoreEventBufferTransferMerged, using the same repeat limits as
+ * the chunked transfer.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceInternalEventBufferTransferMerged(void);
+
+/**
+ * @brief Marks data just written to the internal trace event buffer on this
+ * core as raw data without event headers, so the merged transfer sends it as
+ * is. Only expected for the header data written when tracing starts.
+ *
+ * @param[in] uiSize Size of the raw data.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceInternalEventBufferMarkRaw(uint32_t uiSize);
+
+#else
+
+#define xTraceInternalEventBufferMarkRaw(uiSize) ((void)(uiSize), TRC_SUCCESS)
+
+#endif
+
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+
+/**
+ * @brief Starts asynchronous transfers of internal trace event buffer data.
+ *
+ * Used instead of the synchronous transfers when the stream port defines
+ * TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT, e.g. for UART, SPI or USB drivers that
+ * send using DMA. Such a stream port provides
+ *
+ *	 traceResult xTraceStreamPortWriteDataAsync(void* pvData, uint32_t uiSize, uint32_t uiChannel);
+ *
+ * which starts sending uiSize bytes at pvData and returns TRC_SUCCESS, or
+ * returns TRC_FAIL without sending anything if it is busy. The data is sent
+ * straight from the event buffer and stays untouched until the stream port
+ * calls xTraceInternalEventBufferWriteComplete, so there is at most one write
+ * in flight per channel (core). With TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_CHUNKED
+ * each write is limited to TRC_INTERNAL_BUFFER_CHUNK_SIZE bytes.
+ *
+ * This routine only starts a write for each core that has data and no write
+ * in flight, it doesn't wait for anything.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceInternalEventBufferTransferAsync(void);
+
+/**
+ * @brief Completion callback for xTraceStreamPortWriteDataAsync.
+ *
+ * Called by the stream port, typically from the DMA interrupt, once a write
+ * started by xTraceStreamPortWriteDataAsync has finished. It must not be
+ * called before xTraceStreamPortWriteDataAsync has returned. The sent bytes
+ * are released for new events and the next write is started right away if
+ * there is more data, so the interface is kept busy between TzCtrl runs.
+ *
+ * Writes in flight when the buffer is cleared are discarded on completion.
+ * The stream port may abort them in xTraceStreamPortOnTraceBegin, but must
+ * still report the completion.
+ *
+ * @param[in] uiChannel Channel passed to xTraceStreamPortWriteDataAsync.
+ * @param[in] uiBytesWritten Bytes sent, at most the requested size.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceInternalEventBufferWriteComplete(uint32_t uiChannel, uint32_t uiBytesWritten);
+
+#endif
+
 /**
  * @brief Clears all trace events in the internal trace event buffer.
  * 
@@ -172,6 +289,25 @@ traceResult xTraceInternalEventBufferTransferChunk(void);
  */
 traceResult xTraceInternalEventBufferClear(void);
 
+#if (TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP == 1)
+
+/**
+ * @internal Notifies the TzCtrl task if the internal buffer has filled up to
+ * TRC_CFG_CTRL_TASK_WAKEUP_LEVEL since the last transfer. Committing an event
+ * only sets a flag, so this is called by the kernel port from a point where
+ * the kernel may be called, such as the OS tick interrupt.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceInternalEventBufferNotifyCtrlTask(void);
+
+#else
+
+#define xTraceInternalEventBufferNotifyCtrlTask() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#endif
+
 /** @} */
 
 #ifdef __cplusplus
@@ -187,6 +323,9 @@ traceResult xTraceInternalEventBufferClear(void);
 #define xTraceInternalEventBufferTransfer() (void)(TRC_SUCCESS)
 #define xTraceInternalEventBufferTransferChunk(piBytesWritten, uiChunkSize) ((void)(piBytesWritten), (void)(uiChunkSize), TRC_SUCCESS)
 #define xTraceInternalEventBufferClear() (void)(TRC_SUCCESS)
+#define xTraceInternalEventBufferMarkRaw(uiSize) ((void)(uiSize), TRC_SUCCESS)
+#define xTraceInternalEventBufferWriteComplete(uiChannel, uiBytesWritten) ((void)(uiChannel), (void)(uiBytesWritten), TRC_SUCCESS)
+#define xTraceInternalEventBufferNotifyCtrlTask() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
 
 #endif /* (TRC_USE_INTERNAL_BUFFER == 1)*/
 
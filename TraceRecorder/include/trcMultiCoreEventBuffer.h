@@ -23,6 +23,11 @@
 extern "C" {
 #endif
 
+/* Unless specified in trcConfig.h the buffer is split evenly between the cores */
+#ifndef TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS
+#define TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS { 0 }
+#endif
+
 /**
  * @defgroup trace_multi_core_event_buffer_apis Trace Multi-Core Event Buffer APIs
  * @ingroup trace_recorder_apis
@@ -37,6 +42,18 @@ typedef struct TraceMultiCoreEventBuffer	/* Aligned */
 	TraceEventBuffer_t *xEventBuffer[TRC_CFG_CORE_COUNT]; /**< */
 } TraceMultiCoreEventBuffer_t;
 
+/**
+ * @brief Trace Multi-Core Event Buffer Merge State Structure
+ *
+ * Holds the per-core state of xTraceMultiCoreEventBufferTransferMerged
+ * between calls.
+ */
+typedef struct TraceMultiCoreEventBufferMerge	/* Aligned */
+{
+	uint32_t uiTimestamp[TRC_CFG_CORE_COUNT];		/**< Timestamp of the last transferred event */
+	uint32_t uiPendingBytes[TRC_CFG_CORE_COUNT];	/**< Bytes to transfer as is before the next event header */
+} TraceMultiCoreEventBufferMerge_t;
+
 /**
  * @internal Initialize multi-core event buffer.
  * 
@@ -47,6 +64,10 @@ typedef struct TraceMultiCoreEventBuffer	/* Aligned */
  * old data, the alternatives are TRC_EVENT_BUFFER_OPTION_SKIP and
  * TRC_EVENT_BUFFER_OPTION_OVERWRITE (mutal exclusive).
  * 
+ * The buffer is split between the cores according to
+ * TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS. Each core's part starts with its
+ * TraceEventBuffer_t, and the parts are placed back to back.
+ * 
  * @param[out] pxTraceMultiCoreEventBuffer Pointer to unitialized multi-core trace event buffer.
  * @param[in] uiOptions Trace event buffer options.
  * @param[in] puiBuffer Pointer to buffer that will be used by the multi-core trace event buffer.
@@ -76,6 +97,10 @@ traceResult xTraceMultiCoreEventBufferAlloc(const TraceMultiCoreEventBuffer_t *
 /**
  * @brief Commits the last allocated block to the event buffer.
  *
+ * With TRC_CFG_USE_EVENT_BUFFER_RESERVATION enabled the commit is made to the
+ * core buffer that pvData was allocated from, since the task may have migrated
+ * to another core after the allocation.
+ *
  * @param[in] pxTraceMultiCoreEventBuffer Pointer to initialized multi-core trace event buffer.
  * @param[in] pvData Data pointer.
  * @param[in] uiSize Data size.
@@ -126,7 +151,11 @@ traceResult xTraceMultiCoreEventBufferPush(const TraceMultiCoreEventBuffer_t* co
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+traceResult xTraceMultiCoreEventBufferAllocCommit(const TraceMultiCoreEventBuffer_t * const pxTraceMultiCoreEventBuffer, void *pvData, uint32_t uiSize, int32_t *piBytesWritten);
+#else
 #define xTraceMultiCoreEventBufferAllocCommit(pxTraceMultiCoreEventBuffer, pvData, uiSize, piBytesWritten) xTraceEventBufferAllocCommit((pxTraceMultiCoreEventBuffer)->xEventBuffer[TRC_CFG_GET_CURRENT_CORE()], pvData, uiSize, piBytesWritten)
+#endif
 
 /**
  * @brief Pushes data into multi-core trace event buffer.
@@ -178,6 +207,35 @@ traceResult xTraceMultiCoreEventBufferTransferAll(const TraceMultiCoreEventBuffe
  */
 traceResult xTraceMultiCoreEventBufferTransferChunk(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer, uint32_t uiChunkSize, int32_t* piBytesWritten);
 
+/**
+ * @brief Transfer multi-core trace event buffer data through streamport in
+ * timestamp order.
+ *
+ * This routine interleaves the per-core event buffers so that a single stream
+ * receives the events ordered by timestamp. The oldest event across all cores
+ * is located and it is sent together with the following events of the same
+ * core, up until an event that is newer than the oldest event of another core.
+ * Each such run is a single xTraceStreamPortWriteData call.
+ *
+ * Data registered in uiPendingBytes (e.g. header data without event headers
+ * or the rest of a partially written run) is sent as is before the events
+ * that follow it.
+ *
+ * The transfer stops after roughly uiChunkSize bytes, when all buffers are
+ * empty or when the stream port did not accept all data. At least one event
+ * is always attempted, even if it is larger than uiChunkSize.
+ *
+ * @param[in] pxTraceMultiCoreEventBuffer Pointer to initialized multi-core event buffer.
+ * @param[in] pxMerge Pointer to merge state, zeroed when the buffer is cleared.
+ * @param[in] uiChunkSize Number of bytes to attempt to transfer in total.
+ * @param[out] piBytesWritten Pointer to variable which the routine will write the number
+ * of bytes that was transferred.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceMultiCoreEventBufferTransferMerged(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer, TraceMultiCoreEventBufferMerge_t* const pxMerge, uint32_t uiChunkSize, int32_t* piBytesWritten);
+
 /**
  * @brief Clears all data from event buffer.
  * 
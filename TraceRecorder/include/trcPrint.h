@@ -15,6 +15,11 @@
 #ifndef TRC_PRINT_H
 #define TRC_PRINT_H
 
+/* Unless specified in trcConfig.h, no user event channels are rate limited */
+#ifndef TRC_CFG_PRINT_CHANNEL_LIMITS
+#define TRC_CFG_PRINT_CHANNEL_LIMITS 0
+#endif
+
 #if (TRC_USE_TRACEALYZER_RECORDER == 1) && (TRC_CFG_INCLUDE_USER_EVENTS == 1)
 
 #include <stdarg.h>
@@ -30,10 +35,29 @@ extern "C" {
  * @{
  */
 
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+typedef struct TracePrintChannelLimit	/* Aligned */
+{
+	TraceUnsignedBaseType_t uxChannel;
+	uint32_t uiCompact;
+	uint32_t uiBurst;
+	uint32_t uiTokens;
+	uint32_t uiTicksPerToken;
+	uint32_t uiLastRefill;
+	uint32_t uiSampleRate;
+	uint32_t uiSampleCounter;
+	uint32_t uiSuppressed;
+} TracePrintChannelLimit_t;
+#endif
+
 typedef struct TracePrintData	/* Aligned */
 {
 	TraceStringHandle_t defaultChannel;
 	TraceStringHandle_t consoleChannel;
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+	TracePrintChannelLimit_t xChannelLimits[TRC_CFG_PRINT_CHANNEL_LIMITS];
+	TraceUnsignedBaseType_t uxChannelLimitsUsed;
+#endif
 } TracePrintData_t;
 
 /**
@@ -47,6 +71,93 @@ typedef struct TracePrintData	/* Aligned */
  */
 traceResult xTracePrintInitialize(TracePrintData_t* pxBuffer);
 
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+
+/**
+ * @brief Limits the rate of "User Events" on a channel.
+ *
+ * Events on the channel are first sampled, so only every uiSampleRate:th event
+ * is kept. The kept events then use a token bucket, which holds up to uiBurst
+ * tokens and gains one token every uiTicksPerToken timestamp ticks. An event
+ * without a token is suppressed. The number of suppressed events per channel
+ * is stored as a "User Event" on the same channel when xTraceTzCtrl() runs,
+ * or when xTracePrintReportSuppressed() is called.
+ *
+ * The limits apply to xTracePrint(), xTracePrintF(), xTracePrintF0() -
+ * xTracePrintF4() and xTracePrintLiteralF(). Use
+ * xTracePrintCompactSetChannelLimit() for compact channels. At most
+ * TRC_CFG_PRINT_CHANNEL_LIMITS channels can be limited. Calling this again for
+ * the same channel updates its limits. Fails if no limit could be set, which
+ * is always the case if TRC_CFG_PRINT_CHANNEL_LIMITS is 0 or user events are
+ * disabled.
+ *
+ * Example:
+ *	// At most 10 events in a burst, then one event every millisecond
+ *	xTraceTimestampGetFrequency(&uxFrequency);
+ *	xTracePrintSetChannelLimit(xChannel, 10, uxFrequency / 1000, 0);
+ *
+ * @param[in] xChannel Channel handle. Use 0 for the default channel.
+ * @param[in] uiBurst Token bucket size. 0 disables rate limiting.
+ * @param[in] uiTicksPerToken Timestamp ticks per new token. 0 means the bucket is never refilled.
+ * @param[in] uiSampleRate Keep 1 in uiSampleRate events. 0 or 1 disables sampling.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTracePrintSetChannelLimit(TraceStringHandle_t xChannel, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate);
+
+/**
+ * @brief Limits the rate of compact "User Events" on a channel.
+ *
+ * Same as xTracePrintSetChannelLimit(), but for channels used with
+ * xTracePrintCompactF(), xTracePrintCompactF0() - xTracePrintCompactF4() and
+ * xTracePrintCompactTypedF(). The channel is identified by its string address.
+ *
+ * @param[in] szChannel Channel string.
+ * @param[in] uiBurst Token bucket size. 0 disables rate limiting.
+ * @param[in] uiTicksPerToken Timestamp ticks per new token. 0 means the bucket is never refilled.
+ * @param[in] uiSampleRate Keep 1 in uiSampleRate events. 0 or 1 disables sampling.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTracePrintCompactSetChannelLimit(const char* szChannel, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate);
+
+/**
+ * @brief Stores the number of suppressed "User Events" for each limited channel.
+ *
+ * Called periodically by xTraceTzCtrl(). Channels without suppressed events
+ * since the last report are skipped.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTracePrintReportSuppressed(void);
+
+/**
+ * @internal Applies the channel limits to one "User Event".
+ *
+ * @param[in] uxChannel Channel handle or compact channel string address.
+ *
+ * @retval TRC_FAIL The event is suppressed
+ * @retval TRC_SUCCESS The event should be stored
+ */
+traceResult xTracePrintChannelCheck(TraceUnsignedBaseType_t uxChannel);
+
+/**
+ * @internal Only stores the event created by xEventCreate if the channel limits allow it.
+ */
+#define TRC_PRINT_CHANNEL_FILTER(xChannel, xEventCreate) ((xTracePrintChannelCheck((TraceUnsignedBaseType_t)(xChannel)) == TRC_SUCCESS) ? (xEventCreate) : TRC_SUCCESS)
+
+#else
+
+#define xTracePrintSetChannelLimit(_c, _b, _t, _s) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_5((void)(_c), (void)(_b), (void)(_t), (void)(_s), TRC_FAIL)
+#define xTracePrintCompactSetChannelLimit(_c, _b, _t, _s) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_5((void)(_c), (void)(_b), (void)(_t), (void)(_s), TRC_FAIL)
+#define xTracePrintReportSuppressed() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+#define TRC_PRINT_CHANNEL_FILTER(xChannel, xEventCreate) (xEventCreate)
+
+#endif
+
 /**
  * @brief Generate a "User Event". Channel and format string are only stored in ELF.
  *
@@ -80,7 +191,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintCompactF0(szChannel, szFormat) xTraceEventCreate2(PSF_EVENT_USER_EVENT_FIXED, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat))
+#define xTracePrintCompactF0(szChannel, szFormat) TRC_PRINT_CHANNEL_FILTER(szChannel, xTraceEventCreate2(PSF_EVENT_USER_EVENT_FIXED, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat)))
 
 /**
  * @brief Generate a "User Event" with 1 parameter. Channel and format string are only stored in ELF.
@@ -99,7 +210,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintCompactF1(szChannel, szFormat, uxParam1) xTraceEventCreate3(PSF_EVENT_USER_EVENT_FIXED + 1, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1)
+#define xTracePrintCompactF1(szChannel, szFormat, uxParam1) TRC_PRINT_CHANNEL_FILTER(szChannel, xTraceEventCreate3(PSF_EVENT_USER_EVENT_FIXED + 1, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1))
 
 /**
  * @brief Generate a "User Event" with 2 parameters. Channel and format string are only stored in ELF.
@@ -119,7 +230,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintCompactF2(szChannel, szFormat, uxParam1, uxParam2) xTraceEventCreate4(PSF_EVENT_USER_EVENT_FIXED + 2, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2)
+#define xTracePrintCompactF2(szChannel, szFormat, uxParam1, uxParam2) TRC_PRINT_CHANNEL_FILTER(szChannel, xTraceEventCreate4(PSF_EVENT_USER_EVENT_FIXED + 2, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2))
 
 /**
  * @brief Generate a "User Event" with 3 parameters. Channel and format string are only stored in ELF.
@@ -140,7 +251,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintCompactF3(szChannel, szFormat, uxParam1, uxParam2, uxParam3) xTraceEventCreate5(PSF_EVENT_USER_EVENT_FIXED + 3, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2, uxParam3)
+#define xTracePrintCompactF3(szChannel, szFormat, uxParam1, uxParam2, uxParam3) TRC_PRINT_CHANNEL_FILTER(szChannel, xTraceEventCreate5(PSF_EVENT_USER_EVENT_FIXED + 3, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2, uxParam3))
 
 /**
  * @brief Generate a "User Event" with 4 parameters. Channel and format string are only stored in ELF.
@@ -162,7 +273,63 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintCompactF4(szChannel, szFormat, uxParam1, uxParam2, uxParam3, uxParam4) xTraceEventCreate6(PSF_EVENT_USER_EVENT_FIXED + 4, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2, uxParam3, uxParam4)
+#define xTracePrintCompactF4(szChannel, szFormat, uxParam1, uxParam2, uxParam3, uxParam4) TRC_PRINT_CHANNEL_FILTER(szChannel, xTraceEventCreate6(PSF_EVENT_USER_EVENT_FIXED + 4, (TraceUnsignedBaseType_t)(szChannel), (TraceUnsignedBaseType_t)(szFormat), uxParam1, uxParam2, uxParam3, uxParam4))
+
+/**
+ * @def TRC_PRINT_TYPED_MAX_ARGS
+ * @brief Maximum number of arguments in a typed compact "User Event".
+ */
+#define TRC_PRINT_TYPED_MAX_ARGS 4u
+
+/**
+ * @def TRC_PRINT_TYPED_ARG_INT32
+ * @brief Type descriptor code for a 32-bit integer argument, stored as 4 bytes.
+ */
+#define TRC_PRINT_TYPED_ARG_INT32 0u
+
+/**
+ * @def TRC_PRINT_TYPED_ARG_INT64
+ * @brief Type descriptor code for a 64-bit integer argument, stored as 8 bytes.
+ */
+#define TRC_PRINT_TYPED_ARG_INT64 1u
+
+/**
+ * @def TRC_PRINT_TYPED_ARG_DOUBLE
+ * @brief Type descriptor code for a double argument, stored as 8 bytes IEEE-754.
+ */
+#define TRC_PRINT_TYPED_ARG_DOUBLE 2u
+
+/**
+ * @brief Generate a compact "User Event" with typed arguments.
+ *
+ * Like xTracePrintCompactF(), but the arguments are read using the types given
+ * by the format string instead of as TraceUnsignedBaseType_t. This makes it
+ * possible to log 64-bit integers and floating point values on 32-bit targets.
+ * The values are stored as raw binary, in native byte order, and are formatted
+ * on the host.
+ *
+ * Integer arguments use the length modifiers "hh", "h", "l", "ll", "j" and "z"
+ * to select the size, e.g. "%llu" for uint64_t. "%f", "%e", "%g" and "%a" read
+ * a double (floats are promoted to double when passed). "%s" and "%p" read a
+ * pointer. The "L" modifier (long double) is not supported. A "*" width or
+ * precision reads an int and stores it as a separate 32-bit argument, so it
+ * counts towards TRC_PRINT_TYPED_MAX_ARGS.
+ *
+ * The event carries a type descriptor word. Bits 0-3 hold the number of
+ * arguments and bits 4 + 2 * n hold the TRC_PRINT_TYPED_ARG_* code of argument
+ * n. The arguments follow the descriptor, packed without padding.
+ *
+ * Example:
+ *	xTracePrintCompactTypedF("MyChannel", "Position %f, tick %llu", dPos, ullTick);
+ *
+ * @param[in] szChannel Channel string.
+ * @param[in] szFormat Format string.
+ * @param[in] ... Up to TRC_PRINT_TYPED_MAX_ARGS arguments.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTracePrintCompactTypedF(const char* szChannel, const char* szFormat, ...);
 
 /**
  * @brief Generate a "User Event" with 0 parameters.
@@ -185,7 +352,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintF0(xChannelStringHandle, xFormatStringHandle) xTraceEventCreate2(PSF_EVENT_USER_EVENT_FIXED, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle))
+#define xTracePrintF0(xChannelStringHandle, xFormatStringHandle) TRC_PRINT_CHANNEL_FILTER(xChannelStringHandle, xTraceEventCreate2(PSF_EVENT_USER_EVENT_FIXED, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle)))
 
 /**
  * @brief Generate a "User Event" with 1 parameter.
@@ -209,7 +376,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintF1(xChannelStringHandle, xFormatStringHandle, uxParam1) xTraceEventCreate3(PSF_EVENT_USER_EVENT_FIXED + 1, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1)
+#define xTracePrintF1(xChannelStringHandle, xFormatStringHandle, uxParam1) TRC_PRINT_CHANNEL_FILTER(xChannelStringHandle, xTraceEventCreate3(PSF_EVENT_USER_EVENT_FIXED + 1, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1))
 
 /**
  * @brief Generate a "User Event" with 2 parameters.
@@ -234,7 +401,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintF2(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2) xTraceEventCreate4(PSF_EVENT_USER_EVENT_FIXED + 2, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2)
+#define xTracePrintF2(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2) TRC_PRINT_CHANNEL_FILTER(xChannelStringHandle, xTraceEventCreate4(PSF_EVENT_USER_EVENT_FIXED + 2, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2))
 
 /**
  * @brief Generate a "User Event" with 3 parameters.
@@ -260,7 +427,7 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintF3(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2, uxParam3) xTraceEventCreate5(PSF_EVENT_USER_EVENT_FIXED + 3, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2, uxParam3)
+#define xTracePrintF3(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2, uxParam3) TRC_PRINT_CHANNEL_FILTER(xChannelStringHandle, xTraceEventCreate5(PSF_EVENT_USER_EVENT_FIXED + 3, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2, uxParam3))
 
 /**
  * @brief Generate a "User Event" with 4 parameters.
@@ -287,7 +454,98 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
  * @retval TRC_FAIL Failure
  * @retval TRC_SUCCESS Success
  */
-#define xTracePrintF4(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2, uxParam3, uxParam4) xTraceEventCreate6(PSF_EVENT_USER_EVENT_FIXED + 4, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2, uxParam3, uxParam4)
+#define xTracePrintF4(xChannelStringHandle, xFormatStringHandle, uxParam1, uxParam2, uxParam3, uxParam4) TRC_PRINT_CHANNEL_FILTER(xChannelStringHandle, xTraceEventCreate6(PSF_EVENT_USER_EVENT_FIXED + 4, (TraceUnsignedBaseType_t)(xChannelStringHandle), (TraceUnsignedBaseType_t)(xFormatStringHandle), uxParam1, uxParam2, uxParam3, uxParam4))
+
+/**
+ * @internal Selects the dispatcher of a literal print call from the number of
+ * arguments after the format string. The dispatchers are listed from the most
+ * arguments down to none, preceded by the one for too many arguments.
+ */
+#define TRC_PRINT_SELECT(_f, _1, _2, _3, _4, _5, _6, N, ...) N
+
+/**
+ * @internal Selected for unsupported argument counts. The negative array size
+ * makes the call fail to compile.
+ */
+#define TRC_PRINT_ERROR_TOO_MANY_ARGS(...) ((traceResult)sizeof(char[-1]))
+
+/**
+ * @internal The length of a format string literal, including the null
+ * termination, capped to the 128 characters stored by xTracePrintF().
+ */
+#define TRC_PRINT_LITERAL_LENGTH(szFormat) ((sizeof("" szFormat) > 129u) ? 129u : (uint32_t)sizeof("" szFormat))
+
+/**
+ * @internal Dispatchers for xTracePrintLiteralF().
+ */
+#define TRC_PRINT_LITERAL_F_0(xChannel, szFormat) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 0u)
+#define TRC_PRINT_LITERAL_F_1(xChannel, szFormat, uxParam1) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 1u, (TraceUnsignedBaseType_t)(uxParam1))
+#define TRC_PRINT_LITERAL_F_2(xChannel, szFormat, uxParam1, uxParam2) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 2u, (TraceUnsignedBaseType_t)(uxParam1), (TraceUnsignedBaseType_t)(uxParam2))
+#define TRC_PRINT_LITERAL_F_3(xChannel, szFormat, uxParam1, uxParam2, uxParam3) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 3u, (TraceUnsignedBaseType_t)(uxParam1), (TraceUnsignedBaseType_t)(uxParam2), (TraceUnsignedBaseType_t)(uxParam3))
+#define TRC_PRINT_LITERAL_F_4(xChannel, szFormat, uxParam1, uxParam2, uxParam3, uxParam4) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 4u, (TraceUnsignedBaseType_t)(uxParam1), (TraceUnsignedBaseType_t)(uxParam2), (TraceUnsignedBaseType_t)(uxParam3), (TraceUnsignedBaseType_t)(uxParam4))
+#define TRC_PRINT_LITERAL_F_5(xChannel, szFormat, uxParam1, uxParam2, uxParam3, uxParam4, uxParam5) xTracePrintLiteral(xChannel, "" szFormat, TRC_PRINT_LITERAL_LENGTH(szFormat), 5u, (TraceUnsignedBaseType_t)(uxParam1), (TraceUnsignedBaseType_t)(uxParam2), (TraceUnsignedBaseType_t)(uxParam3), (TraceUnsignedBaseType_t)(uxParam4), (TraceUnsignedBaseType_t)(uxParam5))
+
+/**
+ * @internal Generates a "User Event" from a format string whose length and
+ * argument count are already known. Used by xTracePrintLiteralF().
+ *
+ * @param[in] xChannel Channel handle, or 0 for the default channel.
+ * @param[in] szFormat Format string.
+ * @param[in] uiLength Format string length, including the null termination.
+ * @param[in] uiArgs Number of arguments (0 - 5).
+ * @param[in] ... Arguments as TraceUnsignedBaseType_t.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTracePrintLiteral(TraceStringHandle_t xChannel, const char* szFormat, uint32_t uiLength, uint32_t uiArgs, ...);
+
+/**
+ * @brief Generate a "User Event" from a string literal without scanning it at runtime.
+ *
+ * Produces the same event as xTracePrintF(), but the number of arguments and the
+ * length of the format string are resolved by the preprocessor and compiler, so
+ * the format string is never scanned. The format string must be a string literal
+ * and the number of arguments (0 - 5) is taken from the call, so it must match
+ * the format specifiers. Calls with more than 5 arguments fail to compile.
+ *
+ * As for xTracePrintF(), a channel handle of 0 selects the default channel and
+ * at most 128 characters of the format string are stored.
+ *
+ * Example:
+ *	TraceStringHandle_t xChannel;
+ *
+ *	xTraceStringRegister("MyChannel", &xChannel);
+ *	...
+ *	xTracePrintLiteralF(xChannel, "Hello world! %d %d", 1, 2);
+ *
+ * @param[in] xChannel Channel handle, or 0 for the default channel.
+ * @param[in] ... Format string literal, followed by up to 5 arguments.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+#define xTracePrintLiteralF(xChannel, ...) TRC_PRINT_SELECT(__VA_ARGS__, TRC_PRINT_ERROR_TOO_MANY_ARGS, TRC_PRINT_LITERAL_F_5, TRC_PRINT_LITERAL_F_4, TRC_PRINT_LITERAL_F_3, TRC_PRINT_LITERAL_F_2, TRC_PRINT_LITERAL_F_1, TRC_PRINT_LITERAL_F_0, _unused)(xChannel, __VA_ARGS__)
+
+/**
+ * @brief Generate a compact "User Event" with the argument count resolved at compile time.
+ *
+ * Dispatches to xTracePrintCompactF0() - xTracePrintCompactF4() based on the
+ * number of arguments in the call, avoiding the runtime format scan done by
+ * xTracePrintCompactF(). The same requirements as for xTracePrintCompactF0()
+ * apply to the channel and format strings. Calls with more than 4 arguments
+ * fail to compile.
+ *
+ * Example:
+ *	xTracePrintCompactLiteralF("MyChannel", "Hello world! %d %d", 1, 2);
+ *
+ * @param[in] szChannel Channel string.
+ * @param[in] ... Format string, followed by up to 4 arguments.
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+#define xTracePrintCompactLiteralF(szChannel, ...) TRC_PRINT_SELECT(__VA_ARGS__, TRC_PRINT_ERROR_TOO_MANY_ARGS, TRC_PRINT_ERROR_TOO_MANY_ARGS, xTracePrintCompactF4, xTracePrintCompactF3, xTracePrintCompactF2, xTracePrintCompactF1, xTracePrintCompactF0, _unused)(szChannel, __VA_ARGS__)
 
 /**
  * @brief Generate "User Events" with unformatted text.
@@ -446,6 +704,14 @@ typedef struct TracePrintData
 #define xTracePrintCompactF2 xTracePrintF2
 #define xTracePrintCompactF3 xTracePrintF3
 #define xTracePrintCompactF4 xTracePrintF4
+#define xTracePrintCompactTypedF(_c, _s, ...) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_3((void)(_c), (void)(_s), TRC_SUCCESS)
+
+#define xTracePrintSetChannelLimit(_c, _b, _t, _s) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_5((void)(_c), (void)(_b), (void)(_t), (void)(_s), TRC_FAIL)
+#define xTracePrintCompactSetChannelLimit(_c, _b, _t, _s) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_5((void)(_c), (void)(_b), (void)(_t), (void)(_s), TRC_FAIL)
+#define xTracePrintReportSuppressed() TRC_COMMA_EXPR_TO_STATEMENT_EXPR_1(TRC_SUCCESS)
+
+#define xTracePrintLiteralF(_c, ...) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(_c), TRC_SUCCESS)
+#define xTracePrintCompactLiteralF(_c, ...) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(_c), TRC_SUCCESS)
 
 #endif
 
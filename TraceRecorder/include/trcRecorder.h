@@ -241,6 +241,9 @@ typedef struct TraceRecorderData	/* Aligned */
 	TraceExtensionData_t xExtensionBuffer;			/* aligned */
 	TraceCounterData_t xCounterBuffer;				/* aligned */
 	TraceTaskMonitorData_t xTaskMonitorBuffer;		/* aligned */
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+	TraceStringData_t xStringBuffer;				/* aligned */
+#endif
 } TraceRecorderData_t;
 
 extern TraceRecorderData_t* pxTraceRecorderData;
@@ -349,6 +352,9 @@ traceResult xTraceSetBuffer(TraceRecorderData_t *pxBuffer);
  */
 traceResult xTraceGetEventBuffer(void** ppvBuffer, TraceUnsignedBaseType_t * puiSize);
 
+/* Depends on all of the above */
+#include <trcEventInline.h>
+
 #else /* (TRC_USE_TRACEALYZER_RECORDER == 1) */
 
 #define xTraceInitialize() (TRC_SUCCESS)
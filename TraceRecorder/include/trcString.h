@@ -15,6 +15,16 @@
 #ifndef TRC_STRING_H
 #define TRC_STRING_H
 
+/* Unless specified in trcConfig.h every registration creates a new trace string */
+#ifndef TRC_CFG_STRING_REGISTRY_SIZE
+#define TRC_CFG_STRING_REGISTRY_SIZE 0
+#endif
+
+/* Unless specified in trcConfig.h strings are only reused when registered from the same address */
+#ifndef TRC_CFG_STRING_REGISTRY_MATCH_CONTENT
+#define TRC_CFG_STRING_REGISTRY_MATCH_CONTENT 0
+#endif
+
 #if (TRC_USE_TRACEALYZER_RECORDER == 1)
 
 #include <trcTypes.h>
@@ -29,6 +39,39 @@ extern "C" {
  * @{
  */
 
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+
+/**
+ * @internal Trace String Registry Slot Structure
+ */
+typedef struct TraceStringRegistrySlot	/* Aligned */
+{
+	const char* szString;			/* The registered string, 0 if the slot is free */ /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+	TraceStringHandle_t xString;	/* The trace string it was registered as */
+} TraceStringRegistrySlot_t;
+
+/**
+ * @internal Trace String Data Structure
+ */
+typedef struct TraceStringData	/* Aligned */
+{
+	TraceStringRegistrySlot_t xSlots[TRC_CFG_STRING_REGISTRY_SIZE];
+	TraceUnsignedBaseType_t uxSlotsUsed;
+} TraceStringData_t;
+
+/**
+ * @internal Initialize trace string system.
+ * 
+ * @param[in] pxBuffer Pointer to memory that will be used by the trace
+ * string system.
+ * 
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceStringInitialize(TraceStringData_t* pxBuffer);
+
+#endif /* ((TRC_CFG_STRING_REGISTRY_SIZE) > 0) */
+
 /**
  * @brief Registers a trace string.
  * 
@@ -40,6 +83,10 @@ extern "C" {
  *	 xTraceStringRegister("MyUserEvent", &myEventHandle);
  *	 ...
  *	 xTracePrintF(myEventHandle, "My value is: %d", myValue);
+ *
+ * If TRC_CFG_STRING_REGISTRY_SIZE is set, registering a string again
+ * returns the trace string from the first registration, without using
+ * another entry slot or writing anything to the trace.
  * 
  * @param[in] szString String.
  * @param[out] pString Pointer to uninitialized trace string.
@@ -69,6 +116,8 @@ TraceStringHandle_t xTraceRegisterString(const char *name);
 
 #else
 
+#define xTraceStringInitialize(__pxBuffer) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_2((void)(__pxBuffer), TRC_SUCCESS)
+
 #define xTraceStringRegister(__szString, __pString) TRC_COMMA_EXPR_TO_STATEMENT_EXPR_3((void)(__szString), (void)(__pString), TRC_SUCCESS)
 
 #endif
@@ -153,6 +153,10 @@ traceResult xTraceKernelPortEnable(void);
 
 #define PSF_EVENT_IFE_NEXT									0x08UL
 #define PSF_EVENT_IFE_DIRECT								0x09UL
+#define PSF_EVENT_EVENTS_LOST								0x0CUL
+#define PSF_EVENT_EVENT_STATISTICS							0x0DUL
+#define PSF_EVENT_TS_SYNC									0x0EUL
+#define PSF_EVENT_REPEAT									0x0FUL
 
 #define PSF_EVENT_TASK_CREATE								0x10UL
 #define PSF_EVENT_TASK_DELETE								0x11UL
@@ -203,7 +207,9 @@ traceResult xTraceKernelPortEnable(void);
 
 #define PSF_EVENT_USER_EVENT_FIXED							0x58UL
 
-#define TRC_EVENT_LAST_ID									(PSF_EVENT_USER_EVENT_FIXED + 8ul)
+#define PSF_EVENT_USER_EVENT_TYPED							0x60UL
+
+#define TRC_EVENT_LAST_ID									(PSF_EVENT_USER_EVENT_TYPED)
 
 #endif
 
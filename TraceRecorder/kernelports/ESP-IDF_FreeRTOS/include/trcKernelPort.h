@@ -433,6 +433,10 @@ TraceHeapHandle_t xTraceKernelPortGetSystemHeapHandle(void);
 #define PSF_EVENT_TASK_PRIO_INHERIT							0x05
 #define PSF_EVENT_TASK_PRIO_DISINHERIT						0x06
 #define PSF_EVENT_DEFINE_ISR								0x07
+#define PSF_EVENT_EVENTS_LOST								0x0C
+#define PSF_EVENT_EVENT_STATISTICS							0x0D
+#define PSF_EVENT_TS_SYNC									0x0E
+#define PSF_EVENT_REPEAT									0x0F
 
 #define PSF_EVENT_TASK_CREATE								0x10
 #define PSF_EVENT_QUEUE_CREATE								0x11
@@ -651,7 +655,9 @@ TraceHeapHandle_t xTraceKernelPortGetSystemHeapHandle(void);
 
 #define PSF_EVENT_DEPENDENCY_REGISTER						0xFC
 
-#define TRC_EVENT_LAST_ID									(PSF_EVENT_DEPENDENCY_REGISTER)
+#define PSF_EVENT_USER_EVENT_TYPED							0xFD
+
+#define TRC_EVENT_LAST_ID									(PSF_EVENT_USER_EVENT_TYPED)
 
 
 /*** The trace macros for streaming ******************************************/
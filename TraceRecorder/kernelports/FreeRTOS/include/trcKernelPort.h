@@ -146,6 +146,12 @@ extern "C" {
 #define TRC_KERNEL_PORT_SUPPORTS_TLS 1
 #endif
 
+/* The TzCtrl task waits for a task notification. These were added in FreeRTOS v8.2,
+ * but all v8.x releases share one version setting so v9.0.0 is required. */
+#if (TRC_CFG_FREERTOS_VERSION >= TRC_FREERTOS_VERSION_9_0_0) && (!defined(configUSE_TASK_NOTIFICATIONS) || (configUSE_TASK_NOTIFICATIONS == 1))
+#define TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY 1
+#endif
+
 /**
  * @internal The kernel port data buffer
  */
@@ -190,6 +196,18 @@ traceResult xTraceKernelPortDelay(uint32_t uiTicks);
  */
 unsigned char xTraceKernelPortIsSchedulerSuspended(void);
 
+#if (TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY == 1)
+/**
+ * @internal Wakes the TzCtrl task before its delay has passed. Called from
+ * the OS tick interrupt, outside of the trace critical section, through
+ * xTraceInternalEventBufferNotifyCtrlTask().
+ *
+ * @retval TRC_FAIL Failure
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceKernelPortNotifyCtrlTask(void);
+#endif
+
 /**
  * @internal Set data in TLS.
  
@@ -529,6 +547,10 @@ TraceHeapHandle_t xTraceKernelPortGetSystemHeapHandle(void);
 #define PSF_EVENT_TASK_PRIO_INHERIT							0x05
 #define PSF_EVENT_TASK_PRIO_DISINHERIT						0x06
 #define PSF_EVENT_DEFINE_ISR								0x07
+#define PSF_EVENT_EVENTS_LOST								0x0C
+#define PSF_EVENT_EVENT_STATISTICS							0x0D
+#define PSF_EVENT_TS_SYNC									0x0E
+#define PSF_EVENT_REPEAT									0x0F
 
 #define PSF_EVENT_TASK_CREATE								0x10
 #define PSF_EVENT_QUEUE_CREATE								0x11
@@ -747,7 +769,9 @@ TraceHeapHandle_t xTraceKernelPortGetSystemHeapHandle(void);
 
 #define PSF_EVENT_DEPENDENCY_REGISTER						0xFC
 
-#define TRC_EVENT_LAST_ID									(PSF_EVENT_DEPENDENCY_REGISTER)
+#define PSF_EVENT_USER_EVENT_TYPED							0xFD
+
+#define TRC_EVENT_LAST_ID									(PSF_EVENT_USER_EVENT_TYPED)
 
 /*** The trace macros for streaming ******************************************/
 
@@ -767,23 +791,25 @@ TraceHeapHandle_t xTraceKernelPortGetSystemHeapHandle(void);
 #endif
 
 /* Called on each OS tick. Will call uiPortGetTimestamp to make sure it is called at least once every OS tick. */
+/* Unless pended ticks are caught up on, this is the tick interrupt, where the kernel may be called.
+A TzCtrl wakeup requested by the internal buffer is sent from there. */
 #undef traceTASK_INCREMENT_TICK
 #if TRC_CFG_FREERTOS_VERSION >= TRC_FREERTOS_VERSION_10_3_0
 
 #define traceTASK_INCREMENT_TICK( xTickCount ) \
-	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || xPendedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); } \
+	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || xPendedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); (void)xTraceInternalEventBufferNotifyCtrlTask(); } \
 	OS_TICK_EVENT(uxSchedulerSuspended, (xTickCount) + 1)
 
 #elif TRC_CFG_FREERTOS_VERSION >= TRC_FREERTOS_VERSION_7_5_X
 
 #define traceTASK_INCREMENT_TICK( xTickCount ) \
-	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || uxPendedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); } \
+	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || uxPendedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); (void)xTraceInternalEventBufferNotifyCtrlTask(); } \
 	OS_TICK_EVENT(uxSchedulerSuspended, (xTickCount) + 1)
 
 #else
 
 #define traceTASK_INCREMENT_TICK( xTickCount ) \
-	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || uxMissedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); } \
+	if (uxSchedulerSuspended == ( TraceUnsignedBaseType_t ) pdTRUE || uxMissedTicks == 0) { (void)xTraceTimestampSetOsTickCount((xTickCount) + 1); (void)xTraceInternalEventBufferNotifyCtrlTask(); } \
 	OS_TICK_EVENT(uxSchedulerSuspended, (xTickCount) + 1)
 
 #endif
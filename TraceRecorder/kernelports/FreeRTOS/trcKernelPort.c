@@ -230,15 +230,53 @@ traceResult xTraceKernelPortEnable(void)
 	return TRC_SUCCESS;
 }
 
+#if (TRC_KERNEL_PORT_SUPPORTS_CTRL_TASK_NOTIFY == 1)
+
+traceResult xTraceKernelPortNotifyCtrlTask(void)
+{
+	/* Only called from the tick interrupt, see traceTASK_INCREMENT_TICK. TzCtrl runs
+	at low priority, so there is no need to request a context switch. */
+	if (pxKernelPortData->xTzCtrlHandle != 0)
+	{
+		vTaskNotifyGiveFromISR(pxKernelPortData->xTzCtrlHandle, (void*)0);
+	}
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
 static portTASK_FUNCTION(TzCtrl, pvParameters)
 {
+#if (TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP == 1)
+	TickType_t xDelay = (TickType_t)(TRC_CFG_CTRL_TASK_DELAY);
+#endif
+
 	(void)pvParameters;
 
 	while (1)
 	{
 		xTraceTzCtrl();
 
+#if (TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP == 1)
+		/* Woken early if the internal buffer fills up. Otherwise the delay is doubled
+		each time, up to TRC_CFG_CTRL_TASK_IDLE_DELAY, to avoid needless wakeups
+		while the system is idle. */
+		if (ulTaskNotifyTake(pdTRUE, xDelay) != 0u)
+		{
+			xDelay = (TickType_t)(TRC_CFG_CTRL_TASK_DELAY);
+		}
+		else if (xDelay < (TickType_t)(TRC_CFG_CTRL_TASK_IDLE_DELAY) / 2u)
+		{
+			xDelay *= 2u;
+		}
+		else
+		{
+			xDelay = (TickType_t)(TRC_CFG_CTRL_TASK_IDLE_DELAY);
+		}
+#else
 		vTaskDelay(TRC_CFG_CTRL_TASK_DELAY);
+#endif
 	}
 }
 
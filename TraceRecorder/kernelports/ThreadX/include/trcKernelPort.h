@@ -398,6 +398,13 @@ unsigned char xTraceKernelPortIsSchedulerSuspended(void);
 
 #define PSF_EVENT_DEPENDENCY_REGISTER								4043
 
+#define PSF_EVENT_TS_SYNC											4050
+#define PSF_EVENT_REPEAT											4051
+#define PSF_EVENT_EVENT_STATISTICS									4052
+#define PSF_EVENT_EVENTS_LOST										4053
+
+#define PSF_EVENT_USER_EVENT_TYPED									4054
+
 #define TRC_EVENT_LAST_ID											4096
 
 /* Assign recorder defaults to match ThreadX mappings. */
@@ -317,6 +317,10 @@ void vTraceSetTimerName(void* object, const char* name);
 #define PSF_EVENT_TASK_PRIO_INHERIT							0x05
 #define PSF_EVENT_TASK_PRIO_DISINHERIT						0x06
 #define PSF_EVENT_DEFINE_ISR								0x07
+#define PSF_EVENT_EVENT_STATISTICS							0x08
+#define PSF_EVENT_TS_SYNC									0x0E
+#define PSF_EVENT_REPEAT									0x0F
+#define PSF_EVENT_EVENTS_LOST								0xFD
 
 #define PSF_EVENT_THREAD_SCHED_WAKEUP						0xB6
 #define PSF_EVENT_THREAD_SCHED_ABORT						0x20
@@ -728,7 +732,9 @@ void vTraceSetTimerName(void* object, const char* name);
 #define PSF_EVENT_PIPE_READ_BLOCKING						0x186
 #define PSF_EVENT_PIPE_READ_TIMEOUT							0x187
 
-#define TRC_EVENT_LAST_ID									(PSF_EVENT_PIPE_READ_TIMEOUT)
+#define PSF_EVENT_USER_EVENT_TYPED							0x188
+
+#define TRC_EVENT_LAST_ID									(PSF_EVENT_USER_EVENT_TYPED)
 
 
 #ifdef __cplusplus
@@ -49,6 +49,12 @@ extern "C" {
 
 #define TRC_STREAM_PORT_BUFFER_SIZE (((uint32_t)(TRC_CFG_STREAM_PORT_BUFFER_SIZE) / sizeof(TraceUnsignedBaseType_t)) * sizeof(TraceUnsignedBaseType_t))	/* aligned */
 
+/* uiTriggerBytesLeft value when xTraceRingBufferTrigger hasn't been called, 0 means frozen */
+#define TRC_STREAM_PORT_TRIGGER_NONE 0xFFFFFFFFUL
+
+/* Events aren't lost while the buffer is frozen, they are left out on purpose */
+#define TRC_STREAM_PORT_IS_FROZEN() ((pxStreamPortData != 0) && (pxStreamPortData->uiTriggerBytesLeft == 0u))
+
 /**
 * @brief
 */
@@ -80,6 +86,9 @@ typedef struct TraceStreamPortBuffer
 {
 	TraceMultiCoreEventBuffer_t xMultiCoreEventBuffer;
 	TraceRingBuffer_t xRingBuffer;
+	volatile uint32_t uiTriggerBytesLeft;	/**< Bytes to record after the trigger before freezing */
+	uint32_t reserved0;						/* alignment */
+	TraceStringHandle_t xTriggerChannel;	/**< "Trigger" channel, registered by the first trigger */
 } TraceStreamPortBuffer_t;
 
 extern TraceStreamPortBuffer_t* pxStreamPortData;
@@ -105,7 +114,7 @@ traceResult xTraceStreamPortInitialize(TraceStreamPortBuffer_t* pxBuffer);
  * @retval TRC_FAIL Allocate failed
  * @retval TRC_SUCCESS Success
  */
-#define xTraceStreamPortAllocate(_uiSize, _ppvData) xTraceMultiCoreEventBufferAlloc(&pxStreamPortData->xMultiCoreEventBuffer, _uiSize, _ppvData)
+#define xTraceStreamPortAllocate(_uiSize, _ppvData) ((pxStreamPortData->uiTriggerBytesLeft == 0u) ? TRC_FAIL : xTraceMultiCoreEventBufferAlloc(&pxStreamPortData->xMultiCoreEventBuffer, _uiSize, _ppvData))
 
 /**
  * @brief Commits data to the stream port, depending on the implementation/configuration of the
@@ -119,7 +128,46 @@ traceResult xTraceStreamPortInitialize(TraceStreamPortBuffer_t* pxBuffer);
  * @retval TRC_FAIL Commit failed
  * @retval TRC_SUCCESS Success
  */
-#define xTraceStreamPortCommit(_pvData, _uiSize, _piBytesCommitted) xTraceMultiCoreEventBufferAllocCommit(&pxStreamPortData->xMultiCoreEventBuffer, _pvData, _uiSize, _piBytesCommitted)
+#define xTraceStreamPortCommit(_pvData, _uiSize, _piBytesCommitted) ((pxStreamPortData->uiTriggerBytesLeft == TRC_STREAM_PORT_TRIGGER_NONE) ? xTraceMultiCoreEventBufferAllocCommit(&pxStreamPortData->xMultiCoreEventBuffer, _pvData, _uiSize, _piBytesCommitted) : xTraceStreamPortCommitTriggered(_pvData, _uiSize, _piBytesCommitted))
+
+/**
+ * @internal Commits data after xTraceRingBufferTrigger has been called and
+ * freezes the buffer once the post-trigger data has been recorded.
+ *
+ * @param[in] pvData Data to commit
+ * @param[in] uiSize Data to commit size
+ * @param[out] piBytesCommitted Bytes commited
+ *
+ * @retval TRC_FAIL Commit failed
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceStreamPortCommitTriggered(void* pvData, uint32_t uiSize, int32_t* piBytesCommitted);
+
+/**
+ * @brief Freezes the ring buffer after recording uiPostTriggerBytes more bytes.
+ *
+ * In TRC_STREAM_PORT_RINGBUFFER_MODE_OVERWRITE_WHEN_FULL mode the buffer
+ * otherwise keeps overwriting the oldest events until the target is halted.
+ * Calling this when e.g. a fault is detected keeps the history leading up to
+ * it together with what happens in the following uiPostTriggerBytes bytes,
+ * after which all new events are dropped. The trigger point is marked in the
+ * trace with a user event on the "Trigger" channel, if user events are enabled.
+ *
+ * The buffer is released again when tracing is restarted.
+ *
+ * Example:
+ *	 if (xStatus != OK)
+ *	 {
+ *		 xTraceRingBufferTrigger(1024);
+ *	 }
+ *
+ * @param[in] uiPostTriggerBytes Event data to record after the trigger,
+ * 0 freezes the buffer immediately after the trigger event.
+ *
+ * @retval TRC_FAIL Not initialized or already triggered
+ * @retval TRC_SUCCESS Success
+ */
+traceResult xTraceRingBufferTrigger(uint32_t uiPostTriggerBytes);
 
 /**
  * @brief Writes data through the stream port interface.
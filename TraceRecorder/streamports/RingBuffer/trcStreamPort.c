@@ -34,6 +34,9 @@ traceResult xTraceStreamPortInitialize(TraceStreamPortBuffer_t* pxBuffer)
 	RecorderDataPtr = pxRingBuffer;
 
 	pxRingBuffer->xEventBuffer.uxSize = sizeof(pxRingBuffer->xEventBuffer.uiBuffer);
+
+	pxStreamPortData->uiTriggerBytesLeft = TRC_STREAM_PORT_TRIGGER_NONE;
+	pxStreamPortData->xTriggerChannel = 0;
 	
 #if (TRC_CFG_STREAM_PORT_RINGBUFFER_MODE == TRC_STREAM_PORT_RINGBUFFER_MODE_OVERWRITE_WHEN_FULL)
 	if (xTraceMultiCoreEventBufferInitialize(&pxStreamPortData->xMultiCoreEventBuffer, TRC_EVENT_BUFFER_OPTION_OVERWRITE, pxRingBuffer->xEventBuffer.uiBuffer, sizeof(pxRingBuffer->xEventBuffer.uiBuffer)) == TRC_FAIL)
@@ -97,7 +100,82 @@ traceResult xTraceStreamPortInitialize(TraceStreamPortBuffer_t* pxBuffer)
 
 traceResult xTraceStreamPortOnTraceBegin(void)
 {
+	/* A new session starts with an empty buffer that isn't frozen */
+	pxStreamPortData->uiTriggerBytesLeft = TRC_STREAM_PORT_TRIGGER_NONE;
+
 	return xTraceMultiCoreEventBufferClear(&pxStreamPortData->xMultiCoreEventBuffer);
 }
 
+traceResult xTraceStreamPortCommitTriggered(void* pvData, uint32_t uiSize, int32_t* piBytesCommitted)
+{
+	traceResult xResult;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	xResult = xTraceMultiCoreEventBufferAllocCommit(&pxStreamPortData->xMultiCoreEventBuffer, pvData, uiSize, piBytesCommitted);
+
+	/* Commits may be made outside of the event's critical section when using reservations */
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	if (pxStreamPortData->uiTriggerBytesLeft > uiSize)
+	{
+		pxStreamPortData->uiTriggerBytesLeft -= uiSize;
+	}
+	else
+	{
+		/* Freeze, allocations fail from now on */
+		pxStreamPortData->uiTriggerBytesLeft = 0u;
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return xResult;
+}
+
+traceResult xTraceRingBufferTrigger(uint32_t uiPostTriggerBytes)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	if ((pxStreamPortData == (void*)0) || (pxStreamPortData->uiTriggerBytesLeft != TRC_STREAM_PORT_TRIGGER_NONE))
+	{
+		return TRC_FAIL;
+	}
+
+	if (uiPostTriggerBytes == TRC_STREAM_PORT_TRIGGER_NONE)
+	{
+		uiPostTriggerBytes--;
+	}
+
+#if (TRC_CFG_INCLUDE_USER_EVENTS == 1)
+	/* Registered once, before entering the critical section since it stores an entry */
+	if (pxStreamPortData->xTriggerChannel == 0)
+	{
+		(void)xTraceStringRegister("Trigger", &pxStreamPortData->xTriggerChannel);
+	}
+
+	/* The marker is recorded in full, the post-trigger data follows it. It is written before
+	 * entering the critical section, like any other event. */
+	if (pxStreamPortData->xTriggerChannel != 0)
+	{
+		(void)xTracePrint(pxStreamPortData->xTriggerChannel, "Ring buffer triggered");
+	}
+#endif
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	/* Another trigger may have been handled in the meantime */
+	if (pxStreamPortData->uiTriggerBytesLeft != TRC_STREAM_PORT_TRIGGER_NONE)
+	{
+		TRACE_EXIT_CRITICAL_SECTION();
+
+		return TRC_FAIL;
+	}
+
+	pxStreamPortData->uiTriggerBytesLeft = uiPostTriggerBytes;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
 #endif /*(TRC_USE_TRACEALYZER_RECORDER == 1)*/
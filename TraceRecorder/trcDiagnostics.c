@@ -149,6 +149,12 @@ traceResult xTraceDiagnosticsCheckStatus(void)
 		pxDiagnostics->metrics[TRC_DIAGNOSTICS_STACK_MONITOR_NO_SLOTS] = 0;
 	}
 
+	if (pxDiagnostics->metrics[TRC_DIAGNOSTICS_ENTRY_SYMBOL_POOL_NO_ROOM] > 0)
+	{
+		(void)xTraceWarning(TRC_WARNING_ENTRY_SYMBOL_POOL);
+		pxDiagnostics->metrics[TRC_DIAGNOSTICS_ENTRY_SYMBOL_POOL_NO_ROOM] = 0;
+	}
+
 	return TRC_SUCCESS;
 }
 
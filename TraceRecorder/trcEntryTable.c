@@ -14,6 +14,10 @@
 
 #include <string.h>
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) && (TRC_EXTERNAL_BUFFERS == 1)
+#error "TRC_CFG_ENTRY_SYMBOL_POOL_SIZE cannot be used with this stream port, since the host reads the entry table directly from its buffer."
+#endif
+
 /* (EntryAddress >= FirstEntryAddress) && (EntryAddress < EntryAddressOutsideArray) */
 #define VALIDATE_ENTRY_HANDLE(xEntryHandle) (((void*)(xEntryHandle) >= (void*)&pxEntryTable->axEntries[0]) && ((void*)(xEntryHandle) < (void*)&pxEntryTable->axEntries[TRC_ENTRY_TABLE_SLOTS]))
 
@@ -26,10 +30,30 @@
 /* Index = (EntryAddress - FirstEntryAddress) / EntrySize */
 #define CALCULATE_ENTRY_INDEX(xEntryHandle) (TraceEntryIndex_t)(((TraceUnsignedBaseType_t)(xEntryHandle) - (TraceUnsignedBaseType_t)&pxEntryTable->axEntries[0]) / sizeof(TraceEntry_t))
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+/* The entry index + 1 stored in a hash bucket, 0 if empty */
+#define HASH_BUCKET(uiBucket) pxIndexTable->auiHashBuckets[(uiBucket)]
+
+/* The next bucket to probe, wrapping around */
+#define NEXT_HASH_BUCKET(uiBucket) (((uiBucket) + 1UL) & (TRC_ENTRY_HASH_BUCKETS - 1UL))
+#endif
+
 /* Private function definitions */
+static traceResult prvEntryCreate(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle);
 static traceResult prvEntryIndexInitialize(void);
 static traceResult prvEntryIndexTake(TraceEntryIndex_t *pxIndex);
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+static traceResult prvEntrySymbolPoolFind(const char* szSymbol, uint32_t uiLength, uint32_t uiStart, uint32_t uiEnd, uint32_t* puiOffset); /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvEntrySymbolPoolAdd(const char* szSymbol, uint32_t uiLength, uint32_t* puiOffset); /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+#endif
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+static uint32_t prvEntryHash(const void* const pvAddress);
+static void prvEntryHashInsert(TraceEntryIndex_t xIndex);
+static void prvEntryHashRemove(TraceEntryIndex_t xIndex);
+#endif
+
 /* Variables */
 static TraceEntryTable_t *pxEntryTable TRC_CFG_RECORDER_DATA_ATTRIBUTE;
 static TraceEntryIndexTable_t *pxIndexTable TRC_CFG_RECORDER_DATA_ATTRIBUTE;
@@ -67,15 +91,41 @@ traceResult xTraceEntryTableInitialize(TraceEntryTable_t* const pxBuffer)
 		{
 			pxEntryTable->axEntries[i].xStates[j] = (TraceUnsignedBaseType_t)0;
 		}
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+		pxEntryTable->axEntries[i].uiSymbolOffset = 0u;
+#else
 		pxEntryTable->axEntries[i].szSymbol[0] = (char)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+#endif
 	}
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+	/* Offset 0 is the empty symbol */
+	pxEntryTable->acSymbolPool[0] = (char)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+	pxEntryTable->uiSymbolPoolUsed = 1u;
+	pxEntryTable->reserved = 0u;
+#endif
+
 	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY);
 
 	return TRC_SUCCESS;
 }
 
 traceResult xTraceEntryCreate(TraceEntryHandle_t *pxEntryHandle)
+{
+	return prvEntryCreate((void*)0, pxEntryHandle);
+}
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+traceResult xTraceEntryCreateIndexed(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle)
+{
+	/* This should never fail */
+	TRC_ASSERT(pvAddress != (void*)0);
+
+	return prvEntryCreate(pvAddress, pxEntryHandle);
+}
+#endif
+
+static traceResult prvEntryCreate(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle)
 {
 	uint32_t i;
 	TraceEntryIndex_t xIndex;
@@ -105,7 +155,14 @@ traceResult xTraceEntryCreate(TraceEntryHandle_t *pxEntryHandle)
 
 	pxEntry = &pxEntryTable->axEntries[xIndex];
 	
-	pxEntry->pvAddress = (void*)pxEntry; /* We set a temporary address */
+	if (pvAddress != (void*)0)
+	{
+		pxEntry->pvAddress = pvAddress;
+	}
+	else
+	{
+		pxEntry->pvAddress = (void*)pxEntry; /* We set a temporary address */
+	}
 
 	for (i = 0u; i < (uint32_t)(TRC_ENTRY_TABLE_STATE_COUNT); i++)
 	{
@@ -113,10 +170,21 @@ traceResult xTraceEntryCreate(TraceEntryHandle_t *pxEntryHandle)
 	}
 
 	pxEntry->uiOptions = 0u;
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+	pxEntry->uiSymbolOffset = 0u;
+#else
 	pxEntry->szSymbol[0] = (char)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+#endif
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	/* Temporary addresses are indexed as well, so that lookups behave as without the index */
+	prvEntryHashInsert(xIndex);
+#endif
 
 	*pxEntryHandle = (TraceEntryHandle_t)pxEntry;
 
+	pxIndexTable->uiChangeCount++;
+
 	TRACE_EXIT_CRITICAL_SECTION();
 
 	return TRC_SUCCESS;
@@ -151,6 +219,11 @@ traceResult xTraceEntryDelete(TraceEntryHandle_t xEntryHandle)
 		return TRC_FAIL;
 	}
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	/* Must be removed while the address is still set */
+	prvEntryHashRemove(xIndex);
+#endif
+
 	/* A valid address, so we assume it is OK. */
 	/* We clear the address field which is used on host to see if entries are active. */
 	((TraceEntry_t*)xEntryHandle)->pvAddress = 0;
@@ -158,6 +231,8 @@ traceResult xTraceEntryDelete(TraceEntryHandle_t xEntryHandle)
 	/* Give back the index */
 	GIVE_ENTRY_INDEX(xIndex);
 
+	pxIndexTable->uiChangeCount++;
+
 	TRACE_EXIT_CRITICAL_SECTION();
 
 	return TRC_SUCCESS;
@@ -165,9 +240,18 @@ traceResult xTraceEntryDelete(TraceEntryHandle_t xEntryHandle)
 
 traceResult xTraceEntryFind(const void* const pvAddress, TraceEntryHandle_t* pxEntryHandle)
 {
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	uint32_t uiBucket;
+	uint32_t uiValue;
+#else
 	uint32_t i;
+#endif
 	TraceEntry_t* pxEntry;
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	TRACE_ALLOC_CRITICAL_SECTION();
+#endif
+
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
 
@@ -177,6 +261,31 @@ traceResult xTraceEntryFind(const void* const pvAddress, TraceEntryHandle_t* pxE
 	/* This should never fail */
 	TRC_ASSERT(pvAddress != (void*)0);
 
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	/* Buckets are moved when entries are deleted, so the probe must be locked */
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	uiBucket = prvEntryHash(pvAddress);
+	uiValue = (uint32_t)HASH_BUCKET(uiBucket);
+
+	while (uiValue != 0u)
+	{
+		pxEntry = &pxEntryTable->axEntries[uiValue - 1u];
+		if (pxEntry->pvAddress == pvAddress)
+		{
+			*pxEntryHandle = (TraceEntryHandle_t)pxEntry;
+
+			TRACE_EXIT_CRITICAL_SECTION();
+
+			return TRC_SUCCESS;
+		}
+
+		uiBucket = NEXT_HASH_BUCKET(uiBucket);
+		uiValue = (uint32_t)HASH_BUCKET(uiBucket);
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+#else
 	for (i = 0u; i < (uint32_t)(TRC_ENTRY_TABLE_SLOTS); i++)
 	{
 		pxEntry = &pxEntryTable->axEntries[i];
@@ -187,6 +296,7 @@ traceResult xTraceEntryFind(const void* const pvAddress, TraceEntryHandle_t* pxE
 			return TRC_SUCCESS;
 		}
 	}
+#endif
 
 	return TRC_FAIL;
 }
@@ -194,6 +304,14 @@ traceResult xTraceEntryFind(const void* const pvAddress, TraceEntryHandle_t* pxE
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
 traceResult xTraceEntrySetSymbol(const TraceEntryHandle_t xEntryHandle, const char* szSymbol, uint32_t uiLength)
 {
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+	uint32_t uiOffset = 0u;
+	uint32_t uiPoolUsed;
+	traceResult xFound;
+#endif
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
 
@@ -206,6 +324,39 @@ traceResult xTraceEntrySetSymbol(const TraceEntryHandle_t xEntryHandle, const ch
 	/* Remember the longest symbol name */
 	(void)xTraceDiagnosticsSetIfHigher(TRC_DIAGNOSTICS_ENTRY_SYMBOL_LONGEST_LENGTH, (int32_t)uiLength);
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+	if (uiLength > (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH))
+	{
+		/* The stored entry table still has a fixed symbol size. Set to max. */
+		uiLength = (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH); /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
+	}
+
+	/* This should never fail */
+	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
+
+	/* Symbols are only ever appended to the pool, so the part that is already
+	 * used can be searched with interrupts enabled */
+	uiPoolUsed = pxEntryTable->uiSymbolPoolUsed;
+	xFound = prvEntrySymbolPoolFind(szSymbol, uiLength, 0u, uiPoolUsed, &uiOffset);
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	/* Only symbols added since the search need to be checked with interrupts masked */
+	if ((xFound == TRC_FAIL) && (prvEntrySymbolPoolFind(szSymbol, uiLength, uiPoolUsed, pxEntryTable->uiSymbolPoolUsed, &uiOffset) == TRC_FAIL))
+	{
+		if (prvEntrySymbolPoolAdd(szSymbol, uiLength, &uiOffset) == TRC_FAIL)
+		{
+			/* No room left in the symbol pool, so the entry gets the empty symbol */
+			(void)xTraceDiagnosticsIncrease(TRC_DIAGNOSTICS_ENTRY_SYMBOL_POOL_NO_ROOM);
+		}
+	}
+
+	((TraceEntry_t*)xEntryHandle)->uiSymbolOffset = uiOffset;
+
+	pxIndexTable->uiChangeCount++;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+#else /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
 	if (uiLength >= (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH))
 	{
 		/* No room for null termination. Set to max. */
@@ -224,6 +375,12 @@ traceResult xTraceEntrySetSymbol(const TraceEntryHandle_t xEntryHandle, const ch
 	/* This will also copy the null termination, if possible */
 	memcpy(((TraceEntry_t*)xEntryHandle)->szSymbol, szSymbol, uiLength);
 
+	/* Counted after the copy so that a partially copied symbol is always detected */
+	TRACE_ENTER_CRITICAL_SECTION();
+	pxIndexTable->uiChangeCount++;
+	TRACE_EXIT_CRITICAL_SECTION();
+#endif /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
+
 	return TRC_SUCCESS;
 }
 
@@ -240,68 +397,95 @@ traceResult xTraceEntryGetCount(uint32_t* puiCount)
 	return TRC_SUCCESS;
 }
 
-traceResult xTraceEntryGetAtIndex(uint32_t index, TraceEntryHandle_t* pxEntryHandle)
+traceResult xTraceEntryGetChangeCount(uint32_t* puiChangeCount)
 {
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
 
 	/* This should never fail */
-	TRC_ASSERT(index < (uint32_t)(TRC_ENTRY_TABLE_SLOTS));
-
-	/* This should never fail */
-	TRC_ASSERT(pxEntryHandle != (void*)0);
+	TRC_ASSERT(puiChangeCount != (void*)0);
 
-	*pxEntryHandle = (TraceEntryHandle_t)&pxEntryTable->axEntries[index];
+	*puiChangeCount = pxIndexTable->uiChangeCount;
 
 	return TRC_SUCCESS;
 }
 
-#if ((TRC_CFG_USE_TRACE_ASSERT) == 1)
-
-traceResult xTraceEntryCreateWithAddress(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle)
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+traceResult xTraceEntryGetPooledSymbol(const TraceEntryHandle_t xEntryHandle, const char** pszSymbol)
 {
 	/* This should never fail */
-	TRC_ASSERT(pvAddress != (void*)0);
+	TRC_ASSERT(pszSymbol != (void*)0);
 
-	return TRC_ENTRY_CREATE_WITH_ADDRESS(pvAddress, pxEntryHandle);
+	*pszSymbol = &pxEntryTable->acSymbolPool[((TraceEntry_t*)xEntryHandle)->uiSymbolOffset];
+
+	return TRC_SUCCESS;
 }
 
-traceResult xTraceEntrySetState(const TraceEntryHandle_t xEntryHandle, TraceUnsignedBaseType_t uxStateIndex, TraceUnsignedBaseType_t uxState)
+traceResult xTraceEntryGetStored(const TraceEntryHandle_t xEntryHandle, TraceEntryStored_t* pxStored)
 {
+	uint32_t i;
+	const TraceEntry_t* pxEntry = (const TraceEntry_t*)xEntryHandle;
+	const char* szSymbol; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
 
 	/* This should never fail */
-	TRC_ASSERT(uxStateIndex < (TraceUnsignedBaseType_t)(TRC_ENTRY_TABLE_STATE_COUNT));
+	TRC_ASSERT(pxStored != (void*)0);
 
 	/* This should never fail */
 	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
 
-	return TRC_ENTRY_SET_STATE(xEntryHandle, uxStateIndex, uxState);
+	pxStored->pvAddress = pxEntry->pvAddress;
+
+	for (i = 0u; i < (uint32_t)(TRC_ENTRY_TABLE_STATE_COUNT); i++)
+	{
+		pxStored->xStates[i] = pxEntry->xStates[i];
+	}
+
+	pxStored->uiOptions = pxEntry->uiOptions;
+
+	/* Pooled symbols are at most TRC_ENTRY_TABLE_SYMBOL_LENGTH long, so they always fit */
+	szSymbol = &pxEntryTable->acSymbolPool[pxEntry->uiSymbolOffset];
+	for (i = 0u; (i < (uint32_t)(TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE)) && (szSymbol[i] != (char)0); i++) /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+	{
+		pxStored->szSymbol[i] = szSymbol[i]; /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+	}
+
+	for (; i < (uint32_t)(TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE); i++)
+	{
+		pxStored->szSymbol[i] = (char)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+	}
+
+	return TRC_SUCCESS;
 }
+#endif /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
 
-traceResult xTraceEntrySetOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask)
+traceResult xTraceEntryGetAtIndex(uint32_t index, TraceEntryHandle_t* pxEntryHandle)
 {
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
 
-	/* Does not need to be locked. */
 	/* This should never fail */
-	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
-	
-	return TRC_ENTRY_SET_OPTIONS(xEntryHandle, uiMask);
+	TRC_ASSERT(index < (uint32_t)(TRC_ENTRY_TABLE_SLOTS));
+
+	/* This should never fail */
+	TRC_ASSERT(pxEntryHandle != (void*)0);
+
+	*pxEntryHandle = (TraceEntryHandle_t)&pxEntryTable->axEntries[index];
+
+	return TRC_SUCCESS;
 }
 
-traceResult xTraceEntryClearOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask)
+#if ((TRC_CFG_USE_TRACE_ASSERT) == 1)
+
+traceResult xTraceEntryCreateWithAddress(void* const pvAddress, TraceEntryHandle_t* pxEntryHandle)
 {
 	/* This should never fail */
-	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
+	TRC_ASSERT(pvAddress != (void*)0);
 
-	/* Does not need to be locked. */
-	/* This should never fail */
-	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
-	
-	return TRC_ENTRY_CLEAR_OPTIONS(xEntryHandle, uiMask);
+	return TRC_ENTRY_CREATE_WITH_ADDRESS(pvAddress, pxEntryHandle);
 }
 
 traceResult xTraceEntryGetAddress(const TraceEntryHandle_t xEntryHandle, void **ppvAddress)
@@ -388,6 +572,79 @@ traceResult xTraceEntryGetOptions(const TraceEntryHandle_t xEntryHandle, uint32_
 
 #endif /* ((TRC_CFG_USE_TRACE_ASSERT) == 1) */
 
+/* Setting states and options must update the change count when the entry table is stored in chunks */
+#if ((TRC_CFG_USE_TRACE_ASSERT) == 1) || ((TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE) > 0)
+
+traceResult xTraceEntrySetState(const TraceEntryHandle_t xEntryHandle, TraceUnsignedBaseType_t uxStateIndex, TraceUnsignedBaseType_t uxState)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
+
+	/* This should never fail */
+	TRC_ASSERT(uxStateIndex < (TraceUnsignedBaseType_t)(TRC_ENTRY_TABLE_STATE_COUNT));
+
+	/* This should never fail */
+	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	(void)TRC_ENTRY_SET_STATE(xEntryHandle, uxStateIndex, uxState);
+
+	pxIndexTable->uiChangeCount++;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEntrySetOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
+
+	/* Does not need to be locked. */
+	/* This should never fail */
+	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	(void)TRC_ENTRY_SET_OPTIONS(xEntryHandle, uiMask);
+
+	pxIndexTable->uiChangeCount++;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEntryClearOptions(const TraceEntryHandle_t xEntryHandle, uint32_t uiMask)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_ENTRY));
+
+	/* Does not need to be locked. */
+	/* This should never fail */
+	TRC_ASSERT(VALIDATE_ENTRY_HANDLE(xEntryHandle)); /*cstat !MISRAC2004-17.3 !MISRAC2012-Rule-18.3 Suppress pointer comparison check*/
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	(void)TRC_ENTRY_CLEAR_OPTIONS(xEntryHandle, uiMask);
+
+	pxIndexTable->uiChangeCount++;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+#endif /* ((TRC_CFG_USE_TRACE_ASSERT) == 1) || ((TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE) > 0) */
+
 /* PRIVATE FUNCTIONS */
 
 static traceResult prvEntryIndexInitialize(void)
@@ -400,6 +657,14 @@ static traceResult prvEntryIndexInitialize(void)
 	}
 
 	pxIndexTable->uiFreeIndexCount = TRC_ENTRY_TABLE_SLOTS;
+	pxIndexTable->uiChangeCount = 0u;
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+	for (i = 0u; i < (uint32_t)(TRC_ENTRY_HASH_BUCKETS); i++)
+	{
+		pxIndexTable->auiHashBuckets[i] = 0u;
+	}
+#endif
 
 	return TRC_SUCCESS;
 }
@@ -431,4 +696,134 @@ static traceResult prvEntryIndexTake(TraceEntryIndex_t *pxIndex)
 	return TRC_SUCCESS;
 }
 
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvEntrySymbolPoolFind(const char* szSymbol, uint32_t uiLength, uint32_t uiStart, uint32_t uiEnd, uint32_t* puiOffset)
+{
+	uint32_t uiOffset = uiStart;
+	uint32_t uiPooledLength;
+	const char* acPool = pxEntryTable->acSymbolPool; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+
+	/* Share the symbol if it is already in the pool. This includes the empty symbol at offset 0. */
+	while (uiOffset < uiEnd)
+	{
+		uiPooledLength = (uint32_t)strlen(&acPool[uiOffset]);
+
+		if ((uiPooledLength == uiLength) && (memcmp(&acPool[uiOffset], szSymbol, uiLength) == 0))
+		{
+			*puiOffset = uiOffset;
+
+			return TRC_SUCCESS;
+		}
+
+		uiOffset += uiPooledLength + 1u;
+	}
+
+	return TRC_FAIL;
+}
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvEntrySymbolPoolAdd(const char* szSymbol, uint32_t uiLength, uint32_t* puiOffset)
+{
+	/* Critical Section must be active! */
+	uint32_t uiOffset;
+	char* acPool = pxEntryTable->acSymbolPool; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+
+	if ((uiLength + 1u) > ((uint32_t)(TRC_ENTRY_SYMBOL_POOL_SIZE) - pxEntryTable->uiSymbolPoolUsed))
+	{
+		return TRC_FAIL;
+	}
+
+	uiOffset = pxEntryTable->uiSymbolPoolUsed;
+
+	memcpy(&acPool[uiOffset], szSymbol, uiLength);
+	acPool[uiOffset + uiLength] = (char)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+
+	pxEntryTable->uiSymbolPoolUsed += uiLength + 1u;
+
+	*puiOffset = uiOffset;
+
+	return TRC_SUCCESS;
+}
+
+#endif /* ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0) */
+
+#if (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1)
+
+static uint32_t prvEntryHash(const void* const pvAddress)
+{
+	TraceUnsignedBaseType_t uxAddress = (TraceUnsignedBaseType_t)pvAddress; /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 Suppress conversion from pointer to integer check*/
+	uint32_t uiHash;
+
+	/* Fold in the upper half of 64-bit addresses. Shifted twice to be valid for 32-bit types too. */
+	uiHash = (uint32_t)(uxAddress ^ ((uxAddress >> 16) >> 16));
+
+	/* Multiplicative hashing, with the high bits mixed down since object addresses are aligned */
+	uiHash *= 2654435761UL;
+	uiHash ^= uiHash >> 16;
+
+	return uiHash & (TRC_ENTRY_HASH_BUCKETS - 1UL);
+}
+
+static void prvEntryHashInsert(TraceEntryIndex_t xIndex)
+{
+	/* Critical Section must be active! */
+	uint32_t uiBucket = prvEntryHash(pxEntryTable->axEntries[xIndex].pvAddress);
+
+	/* There are more buckets than entries, so there is always a free one */
+	while (HASH_BUCKET(uiBucket) != 0u)
+	{
+		uiBucket = NEXT_HASH_BUCKET(uiBucket);
+	}
+
+	HASH_BUCKET(uiBucket) = (uint16_t)((uint32_t)xIndex + 1u);
+}
+
+static void prvEntryHashRemove(TraceEntryIndex_t xIndex)
+{
+	/* Critical Section must be active! */
+	uint32_t uiBucket = prvEntryHash(pxEntryTable->axEntries[xIndex].pvAddress);
+	uint32_t uiNext;
+	uint32_t uiHome;
+	uint32_t uiValue = (uint32_t)xIndex + 1u;
+
+	while (HASH_BUCKET(uiBucket) != uiValue)
+	{
+		if (HASH_BUCKET(uiBucket) == 0u)
+		{
+			/* Not indexed */
+			return;
+		}
+
+		uiBucket = NEXT_HASH_BUCKET(uiBucket);
+	}
+
+	/* Close the gap by moving back later entries in the same probe sequence,
+	 * so that lookups can stop at the first empty bucket */
+	uiNext = uiBucket;
+	for (;;)
+	{
+		HASH_BUCKET(uiBucket) = 0u;
+
+		do
+		{
+			uiNext = NEXT_HASH_BUCKET(uiNext);
+			if (HASH_BUCKET(uiNext) == 0u)
+			{
+				return;
+			}
+
+			uiHome = prvEntryHash(pxEntryTable->axEntries[HASH_BUCKET(uiNext) - 1u].pvAddress);
+
+			/* Keep looking while the entry's home bucket lies cyclically in (uiBucket, uiNext] */
+		} while ((uiBucket <= uiNext) ? ((uiBucket < uiHome) && (uiHome <= uiNext)) : ((uiBucket < uiHome) || (uiHome <= uiNext)));
+
+		HASH_BUCKET(uiBucket) = HASH_BUCKET(uiNext);
+		uiBucket = uiNext;
+	}
+}
+
+#endif /* (TRC_CFG_ENTRY_TABLE_HASH_INDEX == 1) */
+
 #endif
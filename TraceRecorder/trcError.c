@@ -149,6 +149,7 @@ static traceResult prvTraceErrorPrint(uint32_t uiErrorCode)
 	case TRC_WARNING_STREAM_PORT_WRITE:
 	case TRC_WARNING_STREAM_PORT_INITIAL_BLOCKING:
 	case TRC_WARNING_STACKMON_NO_SLOTS:
+	case TRC_WARNING_ENTRY_SYMBOL_POOL:
 	case TRC_ERROR_STREAM_PORT_WRITE:
 	case TRC_ERROR_EVENT_CODE_TOO_LARGE:
 	case TRC_ERROR_ISR_NESTING_OVERFLOW:
@@ -247,6 +248,13 @@ static traceResult prvTraceErrorGetDescription(uint32_t uiErrorCode, const char*
 		*pszDesc = "No slots left in Stack Monitor";
 		break;
 
+	case TRC_WARNING_ENTRY_SYMBOL_POOL:
+		/* A symbol name did not fit in the symbol pool and was left empty.
+		Increase TRC_CFG_ENTRY_SYMBOL_POOL_SIZE. */
+
+		*pszDesc = "Exceeded TRC_CFG_ENTRY_SYMBOL_POOL_SIZE";
+		break;
+
 	case TRC_ERROR_STREAM_PORT_WRITE:
 		/* TRC_STREAM_PORT_WRITE_DATA is expected to return 0 when completed successfully.
 		This means there is an error in the communication with host/Tracealyzer. */
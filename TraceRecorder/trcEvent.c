@@ -14,160 +14,715 @@
 
 #include <string.h>
 
-#ifdef TRC_USE_CUSTOM_STREAMPORT_ALLOCATION
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+/* The compact header is 4 bytes, which would misalign 64-bit parameters. The base type size can't
+ * be tested with #if, so a negative array size stops the build if TRC_BASE_TYPE isn't 32-bit. */
+typedef char TraceCompactTimestampsRequire32BitBaseType_t[(sizeof(TraceUnsignedBaseType_t) == 4u) ? 1 : -1];
+#endif
+
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+
+/**
+ * @internal Parameter count used to mark events with packed parameters. The payload then starts
+ * with a length byte followed by that many bytes of zigzag encoded LEB128 varints and is padded
+ * to TraceUnsignedBaseType_t alignment.
+ */
+#define TRC_EVENT_PACKED_PARAM_COUNT 0xFu
+
+/**
+ * @internal Maximum size of one varint encoded parameter.
+ */
+#define TRC_EVENT_PACKED_PARAM_MAX_SIZE ((sizeof(TraceUnsignedBaseType_t) * 8u + 6u) / 7u)
+
+/**
+ * @internal Maximum size of a packed payload, including the length byte and padding.
+ */
+#define TRC_EVENT_PACKED_MAX_SIZE TRC_ALIGN_CEIL(1u + 6u * TRC_EVENT_PACKED_PARAM_MAX_SIZE, sizeof(TraceUnsignedBaseType_t))
+
+/**
+ * @internal Maximum event size. The largest parameter count is reserved for packed events.
+ */
+#define TRC_EVENT_MAX_SIZE (((TRC_MAX_BLOB_SIZE) < (sizeof(TraceEvent0_t) + (TRC_EVENT_PACKED_PARAM_COUNT - 1u) * sizeof(TraceUnsignedBaseType_t))) ? (TRC_MAX_BLOB_SIZE) : (sizeof(TraceEvent0_t) + (TRC_EVENT_PACKED_PARAM_COUNT - 1u) * sizeof(TraceUnsignedBaseType_t)))
+
+/**
+ * @internal Macro optimization for getting trace event size.
+ */
+#define TRC_EVENT_GET_SIZE(pvAddress, puiSize) (*(uint32_t*)(puiSize) = (TRC_EVENT_GET_PARAM_COUNT(((TraceEvent0_t*)(pvAddress))->EventID) == TRC_EVENT_PACKED_PARAM_COUNT) ? \
+	(uint32_t)(sizeof(TraceEvent0_t) + TRC_ALIGN_CEIL(1u + (uint32_t)((const uint8_t*)(pvAddress))[sizeof(TraceEvent0_t)], sizeof(TraceUnsignedBaseType_t))) : \
+	(uint32_t)(sizeof(TraceEvent0_t) + (TRC_EVENT_GET_PARAM_COUNT(((TraceEvent0_t*)(pvAddress))->EventID)) * sizeof(TraceBaseType_t)), TRC_SUCCESS)
+
+#else
+
+/**
+ * @internal Maximum event size.
+ */
+#define TRC_EVENT_MAX_SIZE (TRC_MAX_BLOB_SIZE)
+
+/**
+ * @internal Macro optimization for getting trace event size.
+ */
+#define TRC_EVENT_GET_SIZE(pvAddress, puiSize) (*(uint32_t*)(puiSize) = sizeof(TraceEvent0_t) + (TRC_EVENT_GET_PARAM_COUNT(((TraceEvent0_t*)(pvAddress))->EventID)) * sizeof(TraceBaseType_t), TRC_SUCCESS)
+
+#endif
+
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+static uint32_t prvTraceEventPackParams(const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount, uint8_t* puiPacked);
+#endif
+
+#define TRACE_EVENT_ADD_0_DATA(__pvData, __uxSize) 											\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent0_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_1_DATA(__p1, __pvData, __uxSize)									\
+	TRACE_EVENT_ADD_1(__p1)																	\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent1_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_2_DATA(__p1, __p2, __pvData, __uxSize)								\
+	TRACE_EVENT_ADD_2(__p1, __p2)															\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent2_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_3_DATA(__p1, __p2, __p3, __pvData, __uxSize)						\
+	TRACE_EVENT_ADD_3(__p1, __p2, __p3)														\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent3_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_4_DATA(__p1, __p2, __p3, __p4, __pvData, __uxSize)					\
+	TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)												\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent4_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_5_DATA(__p1, __p2, __p3, __p4, __p5, __pvData, __uxSize)			\
+	TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)											\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent5_t)], __pvData, __uxSize);
+
+#define TRACE_EVENT_ADD_6_DATA(__p1, __p2, __p3, __p4, __p5, __p6, __pvData, __uxSize)		\
+	TRACE_EVENT_ADD_6(__p1, __p2, __p3, __p4, __p5, __p6)									\
+	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent6_t)], __pvData, __uxSize);
+
+TraceEventDataTable_t *pxTraceEventDataTable TRC_CFG_RECORDER_DATA_ATTRIBUTE;
+
+traceResult xTraceEventInitialize(TraceEventDataTable_t* pxBuffer)
+{
+	uint32_t i;
+
+	/* This should never fail */
+	TRC_ASSERT(pxBuffer != (void*)0);
+
+	pxTraceEventDataTable = pxBuffer;
+
+	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
+	{
+		pxTraceEventDataTable->coreEventData[i].eventCounter = 0u;
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+		pxTraceEventDataTable->coreEventData[i].droppedEvents = 0u;
+		pxTraceEventDataTable->coreEventData[i].droppedBytes = 0u;
+		pxTraceEventDataTable->coreEventData[i].lostEvents = 0u;
+		pxTraceEventDataTable->coreEventData[i].lostBytes = 0u;
+#endif
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+		pxTraceEventDataTable->coreEventData[i].latestTimestamp = 0u;
+		pxTraceEventDataTable->coreEventData[i].syncCountdown = 0u;
+		pxTraceEventDataTable->coreEventData[i].timestampDelta = 0u;
+#endif
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+		pxTraceEventDataTable->coreEventData[i].repeatEventCode = TRC_EVENT_REPEAT_NONE;
+		pxTraceEventDataTable->coreEventData[i].repeatCount = 0u;
+#endif
+	}
+
+#if (TRC_CFG_USE_EVENT_GROUP_FILTER == 1)
+	for (i = 0u; i < (TRC_EVENT_GROUP_COUNT / 32u); i++)
+	{
+		pxTraceEventDataTable->uiGroupFilter[i] = 0xFFFFFFFFUL;
+	}
+#endif
+
+#if (TRC_CFG_USE_EVENT_STATISTICS == 1)
+	for (i = 0u; i <= (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES); i++)
+	{
+		pxTraceEventDataTable->xStatistics[i].uiCount = 0u;
+		pxTraceEventDataTable->xStatistics[i].uiBytes = 0u;
+	}
+#endif
+
+	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_EVENT);
+
+	return TRC_SUCCESS;
+}
+
+#if (TRC_CFG_USE_EVENT_GROUP_FILTER == 1)
+
+traceResult xTraceEventGroupEnable(uint32_t uiGroup)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_EVENT));
+
+	/* This should never fail */
+	TRC_ASSERT(uiGroup < TRC_EVENT_GROUP_COUNT);
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	pxTraceEventDataTable->uiGroupFilter[uiGroup >> 5] |= (1UL << (uiGroup & 31u));
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventGroupDisable(uint32_t uiGroup)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_EVENT));
+
+	/* This should never fail */
+	TRC_ASSERT(uiGroup < TRC_EVENT_GROUP_COUNT);
+
+	/* Group 0 holds trace start, object names and similar events that are needed to interpret the trace,
+	 * the recorder's own events may be placed in other groups depending on the kernel port */
+	if (TRC_EVENT_GROUP_IS_REQUIRED(uiGroup))
+	{
+		return TRC_FAIL;
+	}
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	pxTraceEventDataTable->uiGroupFilter[uiGroup >> 5] &= ~(1UL << (uiGroup & 31u));
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+
+traceResult xTraceEventSyncTimestamps(void)
+{
+	uint32_t i;
+
+	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
+	{
+		pxTraceEventDataTable->coreEventData[i].syncCountdown = 0u;
+	}
+
+	return TRC_SUCCESS;
+}
+
+/* Takes the timestamp for the next event on this core and stores its delta. Returns 1 if the
+ * event must be preceded by a sync event with the full timestamp and event count, which is the
+ * case if the delta doesn't fit, if TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL events have passed
+ * or if an event was dropped. Must be called from within the critical section. */
+static uint32_t prvTraceEventTakeTimestamp(TraceCoreEventData_t* pxCoreEventData, uint32_t* puiTimestamp)
+{
+	(void)xTraceTimestampGet(puiTimestamp);
+
+	pxCoreEventData->timestampDelta = *puiTimestamp - pxCoreEventData->latestTimestamp;
+	pxCoreEventData->latestTimestamp = *puiTimestamp;
+
+	if ((pxCoreEventData->syncCountdown == 0u) || (pxCoreEventData->timestampDelta > TRC_EVENT_TS_DELTA_MAX))
+	{
+		pxCoreEventData->syncCountdown = (uint32_t)(TRC_CFG_COMPACT_TIMESTAMP_SYNC_INTERVAL) - 1u;
+		pxCoreEventData->timestampDelta = 0u;
+
+		return 1u;
+	}
+
+	pxCoreEventData->syncCountdown--;
+
+	return 0u;
+}
+
+/* Sets up a sync event, it holds the timestamp and event count of the event that follows it */
+static void prvTraceEventSetSyncData(TraceEvent2_t* pxEventData, const TraceCoreEventData_t* pxCoreEventData, uint32_t uiTimestamp)
+{
+	pxEventData->EventID = TRC_EVENT_SET_PARAM_COUNT(PSF_EVENT_TS_SYNC, 2u);
+	pxEventData->TSDelta = TRC_EVENT_SET_TS_DELTA(0u);
+	pxEventData->uxParams[0] = (TraceUnsignedBaseType_t)uiTimestamp;
+	pxEventData->uxParams[1] = (TraceUnsignedBaseType_t)TRC_EVENT_SET_EVENT_COUNT(pxCoreEventData->eventCounter);
+}
+
+/* Takes the timestamp for the next event and writes a sync event first if needed */
+traceResult prvTraceEventSyncTimestamp(void)
+{
+	TraceCoreEventData_t* pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
+	TraceEvent2_t* pxEventData = (void*)0;
+	int32_t iBytesCommitted = 0;
+	uint32_t uiTimestamp = 0u;
+
+	if (prvTraceEventTakeTimestamp(pxCoreEventData, &uiTimestamp) == 1u)
+	{
+		if (xTraceEventAllocate((uint32_t)sizeof(TraceEvent2_t), (void**)&pxEventData) == TRC_FAIL) /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+		{
+			return TRC_FAIL;
+		}
+
+		prvTraceEventSetSyncData(pxEventData, pxCoreEventData, uiTimestamp);
+
+		TRACE_EVENT_STATISTICS_ADD(PSF_EVENT_TS_SYNC, sizeof(TraceEvent2_t));
+
+		(void)xTraceEventCommit(pxEventData, (uint32_t)sizeof(TraceEvent2_t), &iBytesCommitted);
+		(void)iBytesCommitted;
+	}
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
+/* Defined by stream ports that stop accepting events on purpose, so those aren't counted as dropped */
+#ifndef TRC_STREAM_PORT_IS_FROZEN
+#define TRC_STREAM_PORT_IS_FROZEN() 0
+#endif
+
+void prvTraceEventDropped(uint32_t uiEvents, uint32_t uiBytes)
+{
+	TraceCoreEventData_t* pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	uint32_t uiTimestamp = 0u;
+#endif
+
+	if (TRC_STREAM_PORT_IS_FROZEN())
+	{
+		return;
+	}
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	/* The implicit event count is lost when an event is dropped, so the next event must be preceded by a sync event */
+	pxCoreEventData->syncCountdown = 0u;
+#endif
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	(void)xTraceTimestampGet(&uiTimestamp);
+
+	if (pxCoreEventData->lostEvents == 0u)
+	{
+		pxCoreEventData->lostFirstTimestamp = uiTimestamp;
+	}
+
+	pxCoreEventData->droppedEvents += uiEvents;
+	pxCoreEventData->droppedBytes += uiBytes;
+	pxCoreEventData->lostEvents += uiEvents;
+	pxCoreEventData->lostBytes += uiBytes;
+	pxCoreEventData->lostLastTimestamp = uiTimestamp;
+#else
+	(void)pxCoreEventData;
+	(void)uiEvents;
+	(void)uiBytes;
+#endif
+}
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+
+traceResult prvTraceEventWriteLost(void)
+{
+	TraceCoreEventData_t* pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
+	TraceEvent4_t* pxEventData = (void*)0;
+	int32_t iBytesCommitted = 0;
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	if (prvTraceEventSyncTimestamp() == TRC_FAIL)
+	{
+		return TRC_FAIL;
+	}
+#endif
+
+	if (xTraceEventAllocate((uint32_t)sizeof(TraceEvent4_t), (void**)&pxEventData) == TRC_FAIL) /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+	{
+		return TRC_FAIL;
+	}
+
+	TRACE_EVENT_STATISTICS_ADD(PSF_EVENT_EVENTS_LOST, sizeof(TraceEvent4_t));
+	SET_BASE_EVENT_DATA(pxEventData, PSF_EVENT_EVENTS_LOST, 4u, pxCoreEventData->eventCounter);
+	pxEventData->uxParams[0] = (TraceUnsignedBaseType_t)pxCoreEventData->lostEvents;
+	pxEventData->uxParams[1] = (TraceUnsignedBaseType_t)pxCoreEventData->lostBytes;
+	pxEventData->uxParams[2] = (TraceUnsignedBaseType_t)pxCoreEventData->lostFirstTimestamp;
+	pxEventData->uxParams[3] = (TraceUnsignedBaseType_t)pxCoreEventData->lostLastTimestamp;
+
+	(void)xTraceEventCommit(pxEventData, (uint32_t)sizeof(TraceEvent4_t), &iBytesCommitted);
+	(void)iBytesCommitted;
+
+	/* The marker took the event count of the event being created, which gets the next one */
+	pxCoreEventData->eventCounter++;
+	pxCoreEventData->lostEvents = 0u;
+	pxCoreEventData->lostBytes = 0u;
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventDroppedGet(uint32_t uiCoreId, uint32_t* puiEvents, uint32_t* puiBytes)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_EVENT));
+
+	/* This should never fail */
+	TRC_ASSERT(uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT));
+
+	/* This should never fail */
+	TRC_ASSERT(puiEvents != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(puiBytes != (void*)0);
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	*puiEvents = pxTraceEventDataTable->coreEventData[uiCoreId].droppedEvents;
+	*puiBytes = pxTraceEventDataTable->coreEventData[uiCoreId].droppedBytes;
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventDroppedReset(void)
+{
+	uint32_t i;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
+	{
+		pxTraceEventDataTable->coreEventData[i].droppedEvents = 0u;
+		pxTraceEventDataTable->coreEventData[i].droppedBytes = 0u;
+		pxTraceEventDataTable->coreEventData[i].lostEvents = 0u;
+		pxTraceEventDataTable->coreEventData[i].lostBytes = 0u;
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
+#if (TRC_CFG_USE_EVENT_STATISTICS == 1)
+
+traceResult xTraceEventStatisticsGet(uint32_t uiEventCode, uint32_t* puiCount, uint32_t* puiBytes)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_EVENT));
+
+	/* This should never fail */
+	TRC_ASSERT(puiCount != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(puiBytes != (void*)0);
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	*puiCount = pxTraceEventDataTable->xStatistics[TRC_EVENT_STATISTICS_INDEX(uiEventCode)].uiCount;
+	*puiBytes = pxTraceEventDataTable->xStatistics[TRC_EVENT_STATISTICS_INDEX(uiEventCode)].uiBytes;
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventStatisticsReset(void)
+{
+	uint32_t i;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	for (i = 0u; i <= (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES); i++)
+	{
+		pxTraceEventDataTable->xStatistics[i].uiCount = 0u;
+		pxTraceEventDataTable->xStatistics[i].uiBytes = 0u;
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventStatisticsReport(void)
+{
+	TraceEventStatistics_t xStatistics;
+	uint32_t uiReports = 0u;
+	uint32_t i;
+	static uint32_t uiCurrentIndex = 0u;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_EVENT));
+
+	for (i = 0u; (i <= (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES)) && (uiReports < (uint32_t)(TRC_CFG_EVENT_STATISTICS_MAX_REPORTS)); i++)
+	{
+		/* If uiCurrentIndex is too large, reset it */
+		uiCurrentIndex = (uiCurrentIndex <= (uint32_t)(TRC_CFG_EVENT_STATISTICS_CODES)) ? uiCurrentIndex : 0u;
+
+		/* The count and bytes must be read together */
+		TRACE_ENTER_CRITICAL_SECTION();
+		xStatistics = pxTraceEventDataTable->xStatistics[uiCurrentIndex];
+		TRACE_EXIT_CRITICAL_SECTION();
+
+		if (xStatistics.uiCount != 0u)
+		{
+			(void)xTraceEventCreate3(PSF_EVENT_EVENT_STATISTICS, (TraceUnsignedBaseType_t)uiCurrentIndex, (TraceUnsignedBaseType_t)xStatistics.uiCount, (TraceUnsignedBaseType_t)xStatistics.uiBytes);
+
+			uiReports++;
+		}
+
+		uiCurrentIndex++;
+	}
+
+	return TRC_SUCCESS;
+}
+
+#endif
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+
+/* Writes an event with the given parameters. Used by the coalescing stage, which has already
+ * checked the recorder state and event filter. Must be called from within the critical section,
+ * so the event is allocated and committed without entering one of its own. */
+static traceResult prvTraceEventCreateParams(uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	TraceEvent6_t* pxEventData = (void*)0;
+	int32_t iBytesCommitted = 0;
+	uint32_t uiSize;
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+	TraceUnsignedBaseType_t auxPacked[TRC_EVENT_PACKED_MAX_SIZE / sizeof(TraceUnsignedBaseType_t)] = { 0 };
+	uint8_t* puiPacked = (uint8_t*)auxPacked; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/
+	uint32_t uiPackedSize;
+
+	uiPackedSize = prvTraceEventPackParams(puxParams, uiParamCount, &puiPacked[1]);
+	puiPacked[0] = (uint8_t)uiPackedSize;
+	uiPackedSize = TRC_ALIGN_CEIL(1u + uiPackedSize, sizeof(TraceUnsignedBaseType_t));
+	uiSize = (uint32_t)sizeof(TraceEvent0_t) + uiPackedSize;
+#else
+	uint32_t i;
+
+	uiSize = (uint32_t)sizeof(TraceEvent0_t) + uiParamCount * (uint32_t)sizeof(TraceUnsignedBaseType_t);
+#endif
+
+	pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter++;
+
+	if (TRACE_EVENT_ALLOCATE(uiSize, (void**)&pxEventData) == TRC_FAIL) /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+	{
+		TRACE_EVENT_DROPPED(uiSize);
+
+		return TRC_FAIL;
+	}
+
+	TRACE_EVENT_STATISTICS_ADD(uiEventCode, uiSize);
+	SET_BASE_EVENT_DATA(pxEventData, uiEventCode, (uiSize - sizeof(TraceEvent0_t)) / sizeof(TraceUnsignedBaseType_t), pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter); /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/
+
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+	/* Mark the parameters as packed, this gives the same event size as the count set above */
+	pxEventData->EventID = TRC_EVENT_SET_PARAM_COUNT(uiEventCode, TRC_EVENT_PACKED_PARAM_COUNT);
+
+	TRACE_EVENT_ADD_0_DATA(puiPacked, uiPackedSize);
+#else
+	for (i = 0u; i < uiParamCount; i++)
+	{
+		pxEventData->uxParams[i] = puxParams[i];
+	}
+#endif
+
+	(void)xTraceEventCommit(pxEventData, uiSize, &iBytesCommitted);
+
+	/* We need to use iBytesCommitted for the above call but do not use the value */
+	(void)iBytesCommitted;
+
+	return TRC_SUCCESS;
+}
+
+/* Counts the event if it repeats the latest event in the run on this core, within
+ * TRC_CFG_EVENT_COALESCING_WINDOW timestamp ticks of the event that started the run. With
+ * TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT, the last parameter may also increase by one, which
+ * covers tick counts. Must be called from within the critical section. */
+static traceResult prvTraceEventRepeat(TraceCoreEventData_t* pxCoreEventData, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	uint32_t uiStride = 0u;
+	uint32_t uiTimestamp = 0u;
+	uint32_t i;
 
-#if (TRC_USE_INTERNAL_BUFFER == 1)
-#error The internal buffer should not be enabled while custom streamport allocation is enabled!
+	if ((pxCoreEventData->repeatEventCode != uiEventCode) || (pxCoreEventData->repeatParamCount != uiParamCount))
+	{
+		return TRC_FAIL;
+	}
+
+	(void)xTraceTimestampGet(&uiTimestamp);
+
+	/* The subtraction handles a wrapped timestamp */
+	if ((uiTimestamp - pxCoreEventData->repeatStartTimestamp) > (uint32_t)(TRC_CFG_EVENT_COALESCING_WINDOW))
+	{
+		return TRC_FAIL;
+	}
+
+	for (i = 0u; i < uiParamCount; i++)
+	{
+		if (puxParams[i] != pxCoreEventData->repeatParams[i])
+		{
+#if (TRC_CFG_EVENT_COALESCING_MATCH_INCREMENT == 1)
+			if ((i != (uiParamCount - 1u)) || (puxParams[i] != (pxCoreEventData->repeatParams[i] + 1u)))
+			{
+				return TRC_FAIL;
+			}
+
+			uiStride = 1u;
+#else
+			return TRC_FAIL;
 #endif
+		}
+	}
 
-/* Custom streamport allocation/commit functions should be used */
-#define xTraceEventAllocate(_uiSize, _ppvData) xTraceStreamPortAllocate(_uiSize, _ppvData)
-#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceStreamPortCommit(_pvData, _uiSize, _piBytesCommitted)
+	/* The first repeat decides the stride of the run */
+	if ((pxCoreEventData->repeatCount != 0u) && (pxCoreEventData->repeatStride != uiStride))
+	{
+		return TRC_FAIL;
+	}
 
-#elif (TRC_USE_INTERNAL_BUFFER == 1)
+	if (uiParamCount > 0u)
+	{
+		pxCoreEventData->repeatParams[uiParamCount - 1u] = puxParams[uiParamCount - 1u];
+	}
 
-/* Using the internal event buffer */
-#define xTraceEventAllocate(_uiSize, _ppvData) xTraceInternalEventBufferAlloc(_uiSize, _ppvData)
-#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceInternalEventBufferAllocCommit(_pvData, _uiSize, _piBytesCommitted)
+	pxCoreEventData->repeatStride = uiStride;
+	pxCoreEventData->repeatCount++;
+	pxCoreEventData->repeatTimestamp = uiTimestamp;
 
-#else
+	/* The repeat is counted like a written event, but adds no bytes */
+	pxCoreEventData->eventCounter++;
+	TRACE_EVENT_STATISTICS_ADD(uiEventCode, 0u);
 
-/* Default implementation that will be used if the streamport doesn't implement a custom allocation/commit method and the internal buffer isn't used */
-#define xTraceEventAllocate(_uiSize, _ppvData) ((void)(_uiSize), xTraceStaticBufferGet(_ppvData))
-#define xTraceEventCommit(_pvData, _uiSize, _piBytesCommitted) xTraceStreamPortWriteData(_pvData, _uiSize, TRC_CFG_GET_CURRENT_CORE(), _piBytesCommitted)
+	return TRC_SUCCESS;
+}
 
-#endif
+/* Writes the repeat count of the run on a core, if any. The run of another core is written on
+ * this core, with the core it belongs to as a fourth parameter. Must be called from within the
+ * critical section. */
+static traceResult prvTraceEventWriteRepeats(uint32_t uiCoreId)
+{
+	TraceCoreEventData_t* pxCoreEventData = &pxTraceEventDataTable->coreEventData[uiCoreId];
+	TraceUnsignedBaseType_t uxParams[4];
+	uint32_t uiParamCount = 3u;
 
-/**
- * @internal Macro helper for setting trace event parameter count.
- */
-#define TRC_EVENT_SET_PARAM_COUNT(id, n) ((uint16_t)(((uint16_t)(id)) | ((((uint16_t)(n)) & 0xF) << 12)))
+	if (pxCoreEventData->repeatCount == 0u)
+	{
+		return TRC_SUCCESS;
+	}
 
-/**
- * @internal Macro helper for getting trace event parameter count.
- */
-#define TRC_EVENT_GET_PARAM_COUNT(id) (((id) >> 12u) & 0xFU)
+	uxParams[0] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatCount;
+	uxParams[1] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatTimestamp;
+	uxParams[2] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatStride;
 
-#if (TRC_CFG_CORE_COUNT > 1)
-#define TRC_EVENT_SET_EVENT_COUNT(c)  ((uint16_t)(((TRC_CFG_GET_CURRENT_CORE() & 0xF) << 12) | ((uint16_t)(c) & 0xFFF)))
-#else
-#define TRC_EVENT_SET_EVENT_COUNT(c) ((uint16_t)(c))
-#endif
+	if (uiCoreId != (uint32_t)TRC_CFG_GET_CURRENT_CORE())
+	{
+		uxParams[3] = (TraceUnsignedBaseType_t)uiCoreId;
+		uiParamCount = 4u;
+	}
 
-/**
- * @internal Macro optimization for getting trace event size.
- */
-#define TRC_EVENT_GET_SIZE(pvAddress, puiSize) (*(uint32_t*)(puiSize) = sizeof(TraceEvent0_t) + (TRC_EVENT_GET_PARAM_COUNT(((TraceEvent0_t*)(pvAddress))->EventID)) * sizeof(TraceBaseType_t), TRC_SUCCESS)
+	pxCoreEventData->repeatCount = 0u;
 
-/**
- * @internal Macro helper for setting base event data.
- */
-#define SET_BASE_EVENT_DATA(pxEvent, eventId, paramCount, eventCount) \
-	( \
-		(pxEvent)->EventID = TRC_EVENT_SET_PARAM_COUNT(eventId, paramCount), \
-		(pxEvent)->EventCount = TRC_EVENT_SET_EVENT_COUNT(eventCount), \
-		(void)xTraceTimestampGet(&(pxEvent)->TS) \
-	)
-
-#define TRACE_EVENT_BEGIN_OFFLINE(size) 														\
-	TRACE_ENTER_CRITICAL_SECTION();              										\
-	pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter++; 	\
-	if (xTraceEventAllocate((uint32_t)(size), (void**)&pxEventData) == TRC_FAIL)  /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/ \
-	{                                            										\
-		TRACE_EXIT_CRITICAL_SECTION();              									\
-		return TRC_FAIL; 																\
-	} 																					\
-	SET_BASE_EVENT_DATA(pxEventData, uiEventCode, ((size) - sizeof(TraceEvent0_t)) / sizeof(TraceUnsignedBaseType_t), pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter); /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/
-
-#define TRACE_EVENT_BEGIN(size) 														\
-	/* We need to check this */                  										\
-	if (!xTraceIsRecorderEnabled())              										\
-	{ 																					\
-		return TRC_FAIL;                            									\
-	} 																					\
-	TRACE_EVENT_BEGIN_OFFLINE(size)
-
-
-#define TRACE_EVENT_END(size) 															\
-	(void)xTraceEventCommit(pxEventData, (uint32_t)(size), &iBytesCommitted); 			\
-	TRACE_EXIT_CRITICAL_SECTION(); 														\
-	/* We need to use iBytesCommitted for the above call but do not use the value */	\
-	/* Remove potential warnings */ 													\
-	(void)iBytesCommitted;
+	return prvTraceEventCreateParams(PSF_EVENT_REPEAT, uxParams, uiParamCount);
+}
 
-#define TRACE_EVENT_ADD_1(__p1)									\
-	pxEventData->uxParams[0] = __p1;
+traceResult prvTraceEventCreateCoalesced(uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	TraceCoreEventData_t* pxCoreEventData;
+	traceResult xResult;
+	uint32_t i;
 
-#define TRACE_EVENT_ADD_2(__p1, __p2)							\
-	TRACE_EVENT_ADD_1(__p1)										\
-	pxEventData->uxParams[1] = __p2;
+	TRACE_ALLOC_CRITICAL_SECTION();
 
-#define TRACE_EVENT_ADD_3(__p1, __p2, __p3)						\
-	TRACE_EVENT_ADD_2(__p1, __p2)								\
-	pxEventData->uxParams[2] = __p3;
+	/* This should never fail */
+	TRC_ASSERT(uiParamCount <= 6u);
 
-#define TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)				\
-	TRACE_EVENT_ADD_3(__p1, __p2, __p3)							\
-	pxEventData->uxParams[3] = __p4;
+	/* We need to check this */
+	if (!xTraceIsRecorderEnabled())
+	{
+		return TRC_FAIL;
+	}
 
-#define TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)			\
-	TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)					\
-	pxEventData->uxParams[4] = __p5;
+	/* Filtered events are discarded before they can start a run */
+	if (!xTraceEventGroupIsEnabled(uiEventCode))
+	{
+		return TRC_SUCCESS;
+	}
 
-#define TRACE_EVENT_ADD_6(__p1, __p2, __p3, __p4, __p5, __p6)	\
-	TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)				\
-	pxEventData->uxParams[5] = __p6;
+	TRACE_ENTER_CRITICAL_SECTION();
 
-#define TRACE_EVENT_ADD_0_DATA(__pvData, __uxSize) 											\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent0_t)], __pvData, __uxSize);
+	pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
 
-#define TRACE_EVENT_ADD_1_DATA(__p1, __pvData, __uxSize)									\
-	TRACE_EVENT_ADD_1(__p1)																	\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent1_t)], __pvData, __uxSize);
+	if (prvTraceEventRepeat(pxCoreEventData, uiEventCode, puxParams, uiParamCount) == TRC_SUCCESS)
+	{
+		TRACE_EXIT_CRITICAL_SECTION();
 
-#define TRACE_EVENT_ADD_2_DATA(__p1, __p2, __pvData, __uxSize)								\
-	TRACE_EVENT_ADD_2(__p1, __p2)															\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent2_t)], __pvData, __uxSize);
+		return TRC_SUCCESS;
+	}
 
-#define TRACE_EVENT_ADD_3_DATA(__p1, __p2, __p3, __pvData, __uxSize)						\
-	TRACE_EVENT_ADD_3(__p1, __p2, __p3)														\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent3_t)], __pvData, __uxSize);
+	(void)prvTraceEventWriteRepeats((uint32_t)TRC_CFG_GET_CURRENT_CORE());
 
-#define TRACE_EVENT_ADD_4_DATA(__p1, __p2, __p3, __p4, __pvData, __uxSize)					\
-	TRACE_EVENT_ADD_4(__p1, __p2, __p3, __p4)												\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent4_t)], __pvData, __uxSize);
+	xResult = prvTraceEventCreateParams(uiEventCode, puxParams, uiParamCount);
 
-#define TRACE_EVENT_ADD_5_DATA(__p1, __p2, __p3, __p4, __p5, __pvData, __uxSize)			\
-	TRACE_EVENT_ADD_5(__p1, __p2, __p3, __p4, __p5)											\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent5_t)], __pvData, __uxSize);
+	/* The event starts a new run, unless it was dropped */
+	pxCoreEventData->repeatEventCode = (xResult == TRC_SUCCESS) ? uiEventCode : TRC_EVENT_REPEAT_NONE;
+	pxCoreEventData->repeatParamCount = uiParamCount;
+	(void)xTraceTimestampGet(&pxCoreEventData->repeatStartTimestamp);
+	for (i = 0u; i < uiParamCount; i++)
+	{
+		pxCoreEventData->repeatParams[i] = puxParams[i];
+	}
 
-#define TRACE_EVENT_ADD_6_DATA(__p1, __p2, __p3, __p4, __p5, __p6, __pvData, __uxSize)		\
-	TRACE_EVENT_ADD_6(__p1, __p2, __p3, __p4, __p5, __p6)									\
-	memcpy(&((uint8_t*)pxEventData)[sizeof(TraceEvent6_t)], __pvData, __uxSize);
+	TRACE_EXIT_CRITICAL_SECTION();
 
-TraceEventDataTable_t *pxTraceEventDataTable TRC_CFG_RECORDER_DATA_ATTRIBUTE;
+	return xResult;
+}
 
-traceResult xTraceEventInitialize(TraceEventDataTable_t* pxBuffer)
+traceResult xTraceEventFlushRepeats(void)
 {
+	traceResult xResult = TRC_SUCCESS;
 	uint32_t i;
 
-	/* This should never fail */
-	TRC_ASSERT(pxBuffer != (void*)0);
+	TRACE_ALLOC_CRITICAL_SECTION();
 
-	pxTraceEventDataTable = pxBuffer;
+	/* We need to check this */
+	if (!xTraceIsRecorderEnabled())
+	{
+		return TRC_FAIL;
+	}
 
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	/* A core that has gone idle won't end its own run, so every core is flushed from here */
 	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
 	{
-		pxTraceEventDataTable->coreEventData[i].eventCounter = 0u;
+		if (prvTraceEventWriteRepeats(i) == TRC_FAIL)
+		{
+			xResult = TRC_FAIL;
+		}
+		pxTraceEventDataTable->coreEventData[i].repeatEventCode = TRC_EVENT_REPEAT_NONE;
 	}
 
-	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_EVENT);
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return xResult;
+}
+
+traceResult xTraceEventResetRepeats(void)
+{
+	uint32_t i;
+
+	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
+	{
+		pxTraceEventDataTable->coreEventData[i].repeatEventCode = TRC_EVENT_REPEAT_NONE;
+		pxTraceEventDataTable->coreEventData[i].repeatCount = 0u;
+	}
 
 	return TRC_SUCCESS;
 }
 
+#endif
+
 traceResult xTraceEventCreate0(uint32_t uiEventCode)
 {
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+	return prvTraceEventCreateCoalesced(uiEventCode, (const TraceUnsignedBaseType_t*)0, 0u);
+#else
 	TraceEvent0_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -177,10 +732,18 @@ traceResult xTraceEventCreate0(uint32_t uiEventCode)
 	TRACE_EVENT_END(sizeof(TraceEvent0_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate1(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[1];
+
+	uxParams[0] = uxParam1;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 1u);
+#else
 	TraceEvent1_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -193,10 +756,19 @@ traceResult xTraceEventCreate1(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent1_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate2(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[2];
+
+	uxParams[0] = uxParam1;
+	uxParams[1] = uxParam2;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 2u);
+#else
 	TraceEvent2_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -209,10 +781,20 @@ traceResult xTraceEventCreate2(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent2_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate3(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[3];
+
+	uxParams[0] = uxParam1;
+	uxParams[1] = uxParam2;
+	uxParams[2] = uxParam3;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 3u);
+#else
 	TraceEvent3_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -225,10 +807,21 @@ traceResult xTraceEventCreate3(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent3_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate4(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[4];
+
+	uxParams[0] = uxParam1;
+	uxParams[1] = uxParam2;
+	uxParams[2] = uxParam3;
+	uxParams[3] = uxParam4;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 4u);
+#else
 	TraceEvent4_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -241,10 +834,22 @@ traceResult xTraceEventCreate4(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent4_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate5(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4, TraceUnsignedBaseType_t uxParam5)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[5];
+
+	uxParams[0] = uxParam1;
+	uxParams[1] = uxParam2;
+	uxParams[2] = uxParam3;
+	uxParams[3] = uxParam4;
+	uxParams[4] = uxParam5;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 5u);
+#else
 	TraceEvent5_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -257,10 +862,23 @@ traceResult xTraceEventCreate5(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent5_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreate6(uint32_t uiEventCode, TraceUnsignedBaseType_t uxParam1, TraceUnsignedBaseType_t uxParam2, TraceUnsignedBaseType_t uxParam3, TraceUnsignedBaseType_t uxParam4, TraceUnsignedBaseType_t uxParam5, TraceUnsignedBaseType_t uxParam6)
 {
+#ifdef TRC_EVENT_CREATE_FROM_ARRAY
+	TraceUnsignedBaseType_t uxParams[6];
+
+	uxParams[0] = uxParam1;
+	uxParams[1] = uxParam2;
+	uxParams[2] = uxParam3;
+	uxParams[3] = uxParam4;
+	uxParams[4] = uxParam5;
+	uxParams[5] = uxParam6;
+
+	return TRC_EVENT_CREATE_FROM_ARRAY(uiEventCode, uxParams, 6u);
+#else
 	TraceEvent6_t* pxEventData = (void*)0;
 	int32_t iBytesCommitted = 0;
 
@@ -273,6 +891,7 @@ traceResult xTraceEventCreate6(uint32_t uiEventCode, TraceUnsignedBaseType_t uxP
 	TRACE_EVENT_END(sizeof(TraceEvent6_t));
 
 	return TRC_SUCCESS;
+#endif
 }
 
 traceResult xTraceEventCreateRawBlocking(const void* pxSource, uint32_t ulSize)
@@ -288,12 +907,18 @@ traceResult xTraceEventCreateRawBlocking(const void* pxSource, uint32_t ulSize)
 
 	pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()].eventCounter++;
 	while (xTraceEventAllocate(ulSize, (void**)&pxBuffer) == TRC_FAIL) {}
+	/* Raw data has no event header, so the next event must carry the event count again */
+	TRACE_EVENT_SYNC_REQUIRED();
+	TRACE_EVENT_RESERVATION_END();
 
 	memcpy(pxBuffer, pxSource, ulSize);
 	while (xTraceEventCommit(pxBuffer, ulSize, &iBytesCommitted) == TRC_FAIL) {}
 	(void)iBytesCommitted;
 
-	TRACE_EXIT_CRITICAL_SECTION();
+	/* A merged transfer must not parse this as events */
+	(void)xTraceInternalEventBufferMarkRaw(ulSize);
+
+	TRACE_EVENT_COMMIT_END();
 
 	return TRC_SUCCESS;
 }
@@ -307,9 +932,9 @@ traceResult xTraceEventCreateDataOffline0(uint32_t uiEventCode, const TraceUnsig
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent0_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent0_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent0_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent0_t);
 	}
 
 	TRACE_EVENT_BEGIN_OFFLINE(sizeof(TraceEvent0_t) + uxSize);
@@ -330,9 +955,9 @@ traceResult xTraceEventCreateData0(uint32_t uiEventCode, const TraceUnsignedBase
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent0_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent0_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent0_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent0_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent0_t) + uxSize);
@@ -358,9 +983,9 @@ traceResult xTraceEventCreateData1(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent1_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent1_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent1_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent1_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent1_t) + uxSize);
@@ -387,9 +1012,9 @@ traceResult xTraceEventCreateData2(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent2_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent2_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent2_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent2_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent2_t) + uxSize);
@@ -417,9 +1042,9 @@ traceResult xTraceEventCreateData3(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent3_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent3_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent3_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent3_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent3_t) + uxSize);
@@ -448,9 +1073,9 @@ traceResult xTraceEventCreateData4(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent4_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent4_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent4_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent4_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent4_t) + uxSize);
@@ -480,9 +1105,9 @@ traceResult xTraceEventCreateData5(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent5_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent5_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent5_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent5_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent5_t) + uxSize);
@@ -513,9 +1138,9 @@ traceResult xTraceEventCreateData6(
 
 	/* Align payload size and truncate in case it is too big */
 	uxSize = TRC_ALIGN_CEIL(uxSize, sizeof(TraceUnsignedBaseType_t));
-	if (sizeof(TraceEvent6_t) + uxSize > TRC_MAX_BLOB_SIZE)
+	if (sizeof(TraceEvent6_t) + uxSize > TRC_EVENT_MAX_SIZE)
 	{
-		uxSize = TRC_MAX_BLOB_SIZE - sizeof(TraceEvent6_t);
+		uxSize = TRC_EVENT_MAX_SIZE - sizeof(TraceEvent6_t);
 	}
 
 	TRACE_EVENT_BEGIN(sizeof(TraceEvent6_t) + uxSize);
@@ -527,6 +1152,214 @@ traceResult xTraceEventCreateData6(
 	return TRC_SUCCESS;
 }
 
+/* Adds an event to a batch, committing the batch first if it is full. Must be called from within the critical section. */
+static traceResult prvTraceEventBatchStage(TraceEventBatch_t* pxBatch, TraceCoreEventData_t* pxCoreEventData, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount, const void* const pvData, uint32_t uiDataSize)
+{
+	TraceEvent6_t* pxEventData;
+	uint32_t uiEventSize;
+	uint32_t uiRequiredSize;
+	uint32_t i;
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	uint32_t uiTimestamp = 0u;
+#endif
+
+	/* Align payload size and truncate in case it is too big */
+	uiDataSize = TRC_ALIGN_CEIL(uiDataSize, sizeof(TraceUnsignedBaseType_t)); /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
+	uiEventSize = (uint32_t)sizeof(TraceEvent0_t) + uiParamCount * (uint32_t)sizeof(TraceUnsignedBaseType_t);
+	if (uiEventSize + uiDataSize > TRC_EVENT_MAX_SIZE)
+	{
+		uiDataSize = TRC_EVENT_MAX_SIZE - uiEventSize; /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
+	}
+	uiEventSize += uiDataSize;
+
+	/* Room for a sync event must be left since it isn't known yet if one is needed */
+	uiRequiredSize = uiEventSize;
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	uiRequiredSize += (uint32_t)sizeof(TraceEvent2_t);
+#endif
+
+	if (pxBatch->uiSize + uiRequiredSize > (uint32_t)sizeof(pxBatch->auxData))
+	{
+		/* The batch is full, write what we have so far */
+		(void)xTraceEventBatchCommit(pxBatch);
+	}
+
+	pxCoreEventData->eventCounter++;
+
+	pxEventData = (TraceEvent6_t*)&((uint8_t*)pxBatch->auxData)[pxBatch->uiSize]; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	if (prvTraceEventTakeTimestamp(pxCoreEventData, &uiTimestamp) == 1u)
+	{
+		prvTraceEventSetSyncData((TraceEvent2_t*)pxEventData, pxCoreEventData, uiTimestamp); /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+		TRACE_EVENT_STATISTICS_ADD(PSF_EVENT_TS_SYNC, sizeof(TraceEvent2_t));
+		pxBatch->uiSize += (uint32_t)sizeof(TraceEvent2_t);
+		pxEventData = (TraceEvent6_t*)&((uint8_t*)pxBatch->auxData)[pxBatch->uiSize]; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress pointer checks*/
+	}
+#endif
+
+	TRACE_EVENT_STATISTICS_ADD(uiEventCode, uiEventSize);
+	SET_BASE_EVENT_DATA(pxEventData, uiEventCode, (uiEventSize - sizeof(TraceEvent0_t)) / sizeof(TraceUnsignedBaseType_t), pxCoreEventData->eventCounter);
+
+	for (i = 0u; i < uiParamCount; i++)
+	{
+		pxEventData->uxParams[i] = puxParams[i]; /*cstat !MISRAC2004-17.4_b We need to access every parameter*/
+	}
+
+	if (uiDataSize > 0u)
+	{
+		memcpy(&pxEventData->uxParams[uiParamCount], pvData, uiDataSize);
+	}
+
+	pxBatch->uiSize += uiEventSize;
+	pxBatch->uiCount++;
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventBatchBegin(TraceEventBatch_t* pxBatch)
+{
+	TraceCoreEventData_t* pxCoreEventData;
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1) || (TRC_CFG_USE_EVENT_COALESCING == 1)
+	TraceUnsignedBaseType_t uxParams[4];
+#endif
+
+	/* This should never fail */
+	TRC_ASSERT(pxBatch != (void*)0);
+
+	pxBatch->uiSize = 0u;
+	pxBatch->uiCount = 0u;
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	pxBatch->uiLostSize = 0u;
+#endif
+
+	if (!xTraceIsRecorderEnabled())
+	{
+		return TRC_FAIL;
+	}
+
+	pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	/* A pending lost events marker goes first in the batch. The lost counters are cleared when the batch is written. */
+	if (pxCoreEventData->lostEvents != 0u)
+	{
+		uxParams[0] = (TraceUnsignedBaseType_t)pxCoreEventData->lostEvents;
+		uxParams[1] = (TraceUnsignedBaseType_t)pxCoreEventData->lostBytes;
+		uxParams[2] = (TraceUnsignedBaseType_t)pxCoreEventData->lostFirstTimestamp;
+		uxParams[3] = (TraceUnsignedBaseType_t)pxCoreEventData->lostLastTimestamp;
+		(void)prvTraceEventBatchStage(pxBatch, pxCoreEventData, PSF_EVENT_EVENTS_LOST, uxParams, 4u, (void*)0, 0u);
+		pxBatch->uiLostSize = pxBatch->uiSize;
+	}
+#endif
+
+#if (TRC_CFG_USE_EVENT_COALESCING == 1)
+	/* The repeats of the current run happened before the batched events */
+	if (pxCoreEventData->repeatCount != 0u)
+	{
+		uxParams[0] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatCount;
+		uxParams[1] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatTimestamp;
+		uxParams[2] = (TraceUnsignedBaseType_t)pxCoreEventData->repeatStride;
+		pxCoreEventData->repeatCount = 0u;
+		(void)prvTraceEventBatchStage(pxBatch, pxCoreEventData, PSF_EVENT_REPEAT, uxParams, 3u, (void*)0, 0u);
+	}
+	pxCoreEventData->repeatEventCode = TRC_EVENT_REPEAT_NONE;
+#endif
+
+	(void)pxCoreEventData;
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventBatchAdd(TraceEventBatch_t* pxBatch, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	return xTraceEventBatchAddData(pxBatch, uiEventCode, puxParams, uiParamCount, (void*)0, 0u);
+}
+
+traceResult xTraceEventBatchAddData(TraceEventBatch_t* pxBatch, uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount, const void* const pvData, uint32_t uiDataSize)
+{
+	/* This should never fail */
+	TRC_ASSERT(pxBatch != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(uiParamCount <= 6u);
+
+	/* This should never fail */
+	TRC_ASSERT((uiParamCount == 0u) || (puxParams != (void*)0));
+
+	if (!xTraceIsRecorderEnabled())
+	{
+		return TRC_FAIL;
+	}
+
+	/* Filtered events are discarded */
+	if (!xTraceEventGroupIsEnabled(uiEventCode))
+	{
+		return TRC_SUCCESS;
+	}
+
+	return prvTraceEventBatchStage(pxBatch, &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()], uiEventCode, puxParams, uiParamCount, pvData, uiDataSize);
+}
+
+traceResult xTraceEventBatchCommit(TraceEventBatch_t* pxBatch)
+{
+	void* pvEventData = (void*)0;
+	int32_t iBytesCommitted = 0;
+	uint32_t uiSize;
+	uint32_t uiCount;
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	TraceCoreEventData_t* pxCoreEventData;
+	uint32_t uiLostSize;
+#endif
+
+	/* This should never fail */
+	TRC_ASSERT(pxBatch != (void*)0);
+
+	uiSize = pxBatch->uiSize;
+	uiCount = pxBatch->uiCount;
+	pxBatch->uiSize = 0u;
+	pxBatch->uiCount = 0u;
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	uiLostSize = pxBatch->uiLostSize;
+	pxBatch->uiLostSize = 0u;
+#endif
+
+	if (uiSize == 0u)
+	{
+		return TRC_SUCCESS;
+	}
+
+	if (xTraceEventAllocate(uiSize, &pvEventData) == TRC_FAIL)
+	{
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+		/* A dropped lost events marker isn't counted, its counters are still pending */
+		if (uiLostSize != 0u)
+		{
+			uiCount--;
+			uiSize -= uiLostSize;
+		}
+#endif
+		prvTraceEventDropped(uiCount, uiSize);
+		return TRC_FAIL;
+	}
+
+	memcpy(pvEventData, pxBatch->auxData, uiSize);
+
+	(void)xTraceEventCommit(pvEventData, uiSize, &iBytesCommitted);
+	(void)iBytesCommitted;
+
+#if (TRC_CFG_USE_DROPPED_EVENT_MARKERS == 1)
+	if (uiLostSize != 0u)
+	{
+		pxCoreEventData = &pxTraceEventDataTable->coreEventData[TRC_CFG_GET_CURRENT_CORE()];
+		pxCoreEventData->lostEvents = 0u;
+		pxCoreEventData->lostBytes = 0u;
+	}
+#endif
+
+	return TRC_SUCCESS;
+}
+
 traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize)
 {
 	/* This should never fail */
@@ -535,10 +1368,88 @@ traceResult xTraceEventGetSize(const void* const pvAddress, uint32_t* puiSize)
 	/* This should never fail */
 	TRC_ASSERT(puiSize != (void*)0);
 
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+	(void)TRC_EVENT_GET_SIZE(pvAddress, puiSize); /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/
+
+	/* This should never fail */
+	TRC_ASSERT(*puiSize <= (uint32_t)(TRC_MAX_BLOB_SIZE));
+
+	return TRC_SUCCESS;
+#else
 	/* This should never fail */
 	TRC_ASSERT((sizeof(TraceEvent0_t) + ((uint32_t)(uint16_t)(TRC_EVENT_GET_PARAM_COUNT(((const TraceEvent0_t*)pvAddress)->EventID)) * sizeof(TraceUnsignedBaseType_t))) <= (uint32_t)(TRC_MAX_BLOB_SIZE)); /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/
 	
 	return TRC_EVENT_GET_SIZE(pvAddress, puiSize);
+#endif
+}
+
+#if (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1)
+
+/* Writes the parameters as zigzag encoded LEB128 varints and returns the number of bytes used */
+static uint32_t prvTraceEventPackParams(const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount, uint8_t* puiPacked)
+{
+	TraceUnsignedBaseType_t uxValue;
+	uint32_t uiLength = 0u;
+	uint32_t i;
+
+	for (i = 0u; i < uiParamCount; i++)
+	{
+		/* Zigzag encoding keeps small negative values, like -1, short */
+		uxValue = (puxParams[i] << 1) ^ ((TraceUnsignedBaseType_t)0u - (puxParams[i] >> (sizeof(TraceUnsignedBaseType_t) * 8u - 1u))); /*cstat !MISRAC2004-17.4_b We need to access every parameter*/
+
+		while (uxValue >= 0x80u)
+		{
+			puiPacked[uiLength] = (uint8_t)((uxValue & 0x7Fu) | 0x80u); /*cstat !MISRAC2004-17.4_b We need to access every byte*/
+			uiLength++;
+			uxValue >>= 7;
+		}
+
+		puiPacked[uiLength] = (uint8_t)uxValue; /*cstat !MISRAC2004-17.4_b We need to access every byte*/
+		uiLength++;
+	}
+
+	return uiLength;
+}
+
+traceResult prvTraceEventCreatePacked(uint32_t uiEventCode, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	TraceEvent0_t* pxEventData = (void*)0;
+	int32_t iBytesCommitted = 0;
+	TraceUnsignedBaseType_t auxPacked[TRC_EVENT_PACKED_MAX_SIZE / sizeof(TraceUnsignedBaseType_t)] = { 0 };
+	uint8_t* puiPacked = (uint8_t*)auxPacked; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/
+	uint32_t uiSize;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* We need to check this */
+	if (!xTraceIsRecorderEnabled())
+	{
+		return TRC_FAIL;
+	}
+
+	/* Filtered events are discarded before packing */
+	if (!xTraceEventGroupIsEnabled(uiEventCode))
+	{
+		return TRC_SUCCESS;
+	}
+
+	/* The parameters are packed before entering the critical section */
+	uiSize = prvTraceEventPackParams(puxParams, uiParamCount, &puiPacked[1]);
+	puiPacked[0] = (uint8_t)uiSize;
+	uiSize = TRC_ALIGN_CEIL(1u + uiSize, sizeof(TraceUnsignedBaseType_t));
+
+	TRACE_EVENT_BEGIN_OFFLINE(sizeof(TraceEvent0_t) + uiSize);
+
+	/* Mark the parameters as packed, this gives the same event size as the count set above */
+	pxEventData->EventID = TRC_EVENT_SET_PARAM_COUNT(uiEventCode, TRC_EVENT_PACKED_PARAM_COUNT);
+
+	TRACE_EVENT_ADD_0_DATA(puiPacked, uiSize);
+
+	TRACE_EVENT_END(sizeof(TraceEvent0_t) + uiSize);
+
+	return TRC_SUCCESS;
 }
 
 #endif
+
+#endif
@@ -12,6 +12,26 @@
 
 #if (TRC_USE_TRACEALYZER_RECORDER == 1)
 
+/* If a custom TRC_CFG_MEMORY_BARRIER is defined it will override the default definition */
+#ifdef TRC_CFG_MEMORY_BARRIER
+#define TRC_EVENT_BUFFER_MEMORY_BARRIER() TRC_CFG_MEMORY_BARRIER()
+#elif (TRC_CFG_CORE_COUNT > 1) && defined(__GNUC__)
+#define TRC_EVENT_BUFFER_MEMORY_BARRIER() __sync_synchronize()
+#elif (TRC_CFG_CORE_COUNT > 1) && defined(__ICCARM__)
+#include <intrinsics.h>
+#define TRC_EVENT_BUFFER_MEMORY_BARRIER() __DMB()
+#elif defined(__GNUC__)
+/* The producers and the consumer share a core, only compiler reordering must be prevented */
+#define TRC_EVENT_BUFFER_MEMORY_BARRIER() __asm volatile ("" ::: "memory")
+#else
+#define TRC_EVENT_BUFFER_MEMORY_BARRIER()
+#endif
+
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+/* The block index of an overwrite buffer is placed directly after the event data */
+#define TRC_EVENT_BUFFER_BLOCK_INDEX(pxTraceEventBuffer) ((uint32_t*)(void*)&(pxTraceEventBuffer)->puiBuffer[(pxTraceEventBuffer)->uiSize]) /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/ /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+#endif
+
 traceResult xTraceEventBufferInitialize(TraceEventBuffer_t* pxTraceEventBuffer, uint32_t uiOptions,
 	uint8_t* puiBuffer, uint32_t uiSize)
 {
@@ -24,6 +44,23 @@ traceResult xTraceEventBufferInitialize(TraceEventBuffer_t* pxTraceEventBuffer,
 	/* This should never fail */
 	TRC_ASSERT(uiSize != 0u);
 
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	if (uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
+	{
+		/* Every block needs an index entry after the event data */
+		uiSize = (uiSize / ((uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) + (uint32_t)sizeof(uint32_t))) * (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE);
+
+		/* This should never fail */
+		TRC_ASSERT(uiSize != 0u);
+	}
+#endif
+
+#if (TRC_CFG_EVENT_BUFFER_POW2_SIZE == 1)
+	/* Indexes are wrapped with a mask */
+	/* This should never fail */
+	TRC_ASSERT((uiSize & (uiSize - 1u)) == 0u);
+#endif
+
 	pxTraceEventBuffer->uiOptions = uiOptions;
 	pxTraceEventBuffer->uiHead = 0u;
 	pxTraceEventBuffer->uiTail = 0u;
@@ -33,12 +70,128 @@ traceResult xTraceEventBufferInitialize(TraceEventBuffer_t* pxTraceEventBuffer,
 	pxTraceEventBuffer->uiSlack = 0u;
 	pxTraceEventBuffer->uiNextHead = 0u;
 	pxTraceEventBuffer->uiTimerWraparounds = 0u;
+	pxTraceEventBuffer->uiReserveDepth = 0u;
+	pxTraceEventBuffer->uiDroppedEvents = 0u;
+
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	if (uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
+	{
+		/* The first event will be written at the start of block 0 */
+		TRC_EVENT_BUFFER_BLOCK_INDEX(pxTraceEventBuffer)[0] = 0u;
+	}
+#endif
 
 	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_EVENT_BUFFER);
 
 	return TRC_SUCCESS;
 }
 
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+/**
+ * @brief Updates the block index after the region between uiFrom and uiTo has been written.
+ *
+ * Every block starting inside the region (excluding uiFrom) gets uiTo as its
+ * first event, since that is where the next event will be written. uiTo may
+ * be past the end of the buffer if the region wraps.
+ *
+ * @param[in] pxTraceEventBuffer Pointer to initialized trace event buffer.
+ * @param[in] uiFrom Start of the written region.
+ * @param[in] uiTo End of the written region.
+ */
+static void prvTraceEventBufferIndexBlocks(const TraceEventBuffer_t *pxTraceEventBuffer, uint32_t uiFrom, uint32_t uiTo)
+{
+	uint32_t* puiBlockIndex = TRC_EVENT_BUFFER_BLOCK_INDEX(pxTraceEventBuffer);
+	uint32_t uiBlockCount = pxTraceEventBuffer->uiSize / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE);
+	uint32_t uiBlock = (uiFrom / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE)) + 1u;
+	uint32_t uiLastBlock = uiTo / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE);
+	uint32_t uiNextEvent = uiTo;
+
+	if (uiNextEvent >= pxTraceEventBuffer->uiSize)
+	{
+		uiNextEvent -= pxTraceEventBuffer->uiSize;
+	}
+
+	for (; uiBlock <= uiLastBlock; uiBlock++)
+	{
+		puiBlockIndex[(uiBlock < uiBlockCount) ? uiBlock : (uiBlock - uiBlockCount)] = uiNextEvent;
+	}
+}
+
+/**
+ * @brief Frees the events in the oldest block of the Event Buffer.
+ *
+ * Moves the tail to the first event of the block following the tail, or to
+ * the end of the data if the data ends before that block.
+ *
+ * @param[in] pxTraceEventBuffer Pointer to initialized trace event buffer.
+ * @param[in] uiUsed Nr of bytes from the tail to the end of the data.
+ *
+ * @returns Nr of bytes freed.
+ */
+static uint32_t prvTraceEventBufferPopBlock(TraceEventBuffer_t *pxTraceEventBuffer, uint32_t uiUsed)
+{
+	uint32_t uiTail = pxTraceEventBuffer->uiTail;
+	uint32_t uiBlockStart = ((uiTail / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE)) + 1u) * (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE);
+	uint32_t uiNewTail;
+	uint32_t uiFreed;
+
+	/* Blocks that the data doesn't reach have a stale index from the previous lap */
+	if ((uiBlockStart - uiTail) >= uiUsed)
+	{
+		uiFreed = uiUsed;
+		uiNewTail = TRC_EVENT_BUFFER_WRAP(uiTail + uiUsed, pxTraceEventBuffer->uiSize);
+	}
+	else
+	{
+		if (uiBlockStart == pxTraceEventBuffer->uiSize)
+		{
+			uiBlockStart = 0u;
+		}
+
+		uiNewTail = TRC_EVENT_BUFFER_BLOCK_INDEX(pxTraceEventBuffer)[uiBlockStart / (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE)];
+		uiFreed = (uiNewTail > uiTail) ? (uiNewTail - uiTail) : ((uiNewTail + pxTraceEventBuffer->uiSize) - uiTail);
+	}
+
+	pxTraceEventBuffer->uiTail = uiNewTail;
+
+	return uiFreed;
+}
+#endif
+
+/**
+ * @brief Reads a head or tail index owned by the other side of the buffer.
+ *
+ * Accesses to the buffer data made after this call are not reordered before it.
+ *
+ * @param[in] puiIndex Pointer to the index.
+ *
+ * @returns The index.
+ */
+static uint32_t prvTraceEventBufferLoadAcquire(const volatile uint32_t *puiIndex)
+{
+	uint32_t uiIndex = *puiIndex;
+
+	TRC_EVENT_BUFFER_MEMORY_BARRIER();
+
+	return uiIndex;
+}
+
+/**
+ * @brief Publishes a head or tail index to the other side of the buffer.
+ *
+ * Accesses to the buffer data (and uiSlack) made before this call are
+ * completed before the index is updated.
+ *
+ * @param[out] puiIndex Pointer to the index.
+ * @param[in] uiIndex The new index.
+ */
+static void prvTraceEventBufferStoreRelease(volatile uint32_t *puiIndex, uint32_t uiIndex)
+{
+	TRC_EVENT_BUFFER_MEMORY_BARRIER();
+
+	*puiIndex = uiIndex;
+}
+
 /**
  * @brief Pops the oldest event from the Event Buffer.
  * 
@@ -49,6 +202,10 @@ traceResult xTraceEventBufferInitialize(TraceEventBuffer_t* pxTraceEventBuffer,
  */
 static traceResult prvTraceEventBufferPop(TraceEventBuffer_t *pxTraceEventBuffer)
 {
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	/* Free the whole oldest block */
+	pxTraceEventBuffer->uiFree += prvTraceEventBufferPopBlock(pxTraceEventBuffer, pxTraceEventBuffer->uiSize - pxTraceEventBuffer->uiFree);
+#else
 	uint32_t uiFreeSize = 0u;
 
 	/* Get size of event we are freeing */
@@ -58,13 +215,22 @@ static traceResult prvTraceEventBufferPop(TraceEventBuffer_t *pxTraceEventBuffer
 	pxTraceEventBuffer->uiFree += uiFreeSize;
 
 	/* Update tail to point to the new last event */
-	pxTraceEventBuffer->uiTail = (pxTraceEventBuffer->uiTail + uiFreeSize) % pxTraceEventBuffer->uiSize;
+	pxTraceEventBuffer->uiTail = TRC_EVENT_BUFFER_WRAP(pxTraceEventBuffer->uiTail + uiFreeSize, pxTraceEventBuffer->uiSize);
+#endif
 
 	return TRC_SUCCESS;
 }
 
 static traceResult prvTraceEventBufferAllocPop(TraceEventBuffer_t *pxTraceEventBuffer)
 {
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	uint32_t uiTail = pxTraceEventBuffer->uiTail;
+	uint32_t uiNextHead = pxTraceEventBuffer->uiNextHead;
+
+	/* The data ends at the last allocation and the slack area is covered by
+	 * the index, so the whole oldest block can be freed. */
+	(void)prvTraceEventBufferPopBlock(pxTraceEventBuffer, (uiNextHead >= uiTail) ? (uiNextHead - uiTail) : ((uiNextHead + pxTraceEventBuffer->uiSize) - uiTail));
+#else
 	uint32_t uiFreeSize = 0u;
 
 	/* Check if tail is in, or at the start of the slack area. We do not want to call
@@ -82,8 +248,9 @@ static traceResult prvTraceEventBufferAllocPop(TraceEventBuffer_t *pxTraceEventB
 		TRC_ASSERT_ALWAYS_EVALUATE(xTraceEventGetSize(((void*)&(pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiTail])), &uiFreeSize) == TRC_SUCCESS); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
 		/* Update tail to point to the new last event */
-		pxTraceEventBuffer->uiTail = (pxTraceEventBuffer->uiTail + uiFreeSize) % pxTraceEventBuffer->uiSize;
+		pxTraceEventBuffer->uiTail = TRC_EVENT_BUFFER_WRAP(pxTraceEventBuffer->uiTail + uiFreeSize, pxTraceEventBuffer->uiSize);
 	}
+#endif
 
 	return TRC_SUCCESS;
 }
@@ -94,6 +261,9 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 	uint32_t uiHead;
 	uint32_t uiTail;
 	uint32_t uiBufferSize;
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	uint32_t uiAllocHead;
+#endif
 
 	/* This should never fail */
 	TRC_ASSERT(pxTraceEventBuffer != (void*)0);
@@ -109,24 +279,54 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 	/* This should never fail */
 	TRC_ASSERT(uiSize <= uiBufferSize);
 
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+	/* Nothing is outstanding, everything up to the reservation head has been
+	 * committed and can be published before we reserve more. */
+	if (pxTraceEventBuffer->uiReserveDepth == 0u)
+	{
+		prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiHead, pxTraceEventBuffer->uiNextHead);
+	}
+
+	/* Allocations are made from the reservation head since there might be
+	 * uncommitted allocations between uiHead and uiNextHead. */
+	uiHead = pxTraceEventBuffer->uiNextHead;
+#else
+	uiHead = pxTraceEventBuffer->uiHead;
+#endif
+
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	uiAllocHead = uiHead;
+#endif
+
 	/* Handle overwrite buffer allocation, since this kind of allocation modifies
 	 * both head and tail it should only be used for internal buffers without any
 	 * flushing calls (Streaming Ringbuffer)
 	 */
 	if (pxTraceEventBuffer->uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
 	{
-		if (pxTraceEventBuffer->uiHead >= pxTraceEventBuffer->uiTail)
+		if (uiHead >= pxTraceEventBuffer->uiTail)
 		{
 			/* Do we have enough space to directly allocate from the buffer? */
-			if ((uiBufferSize - pxTraceEventBuffer->uiHead) > uiSize)
+			if ((uiBufferSize - uiHead) > uiSize)
 			{
-				*ppvData = &pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
-				pxTraceEventBuffer->uiNextHead = (pxTraceEventBuffer->uiHead  + uiSize) % uiBufferSize;
+				*ppvData = &pxTraceEventBuffer->puiBuffer[uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+				pxTraceEventBuffer->uiNextHead = TRC_EVENT_BUFFER_WRAP(uiHead + uiSize, uiBufferSize);
 			}
 			/* There wasn't enough space for a direct alloc, handle freeing up
 			 * space and wrapping. */
 			else
 			{
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+				/* Freeing space could evict a reservation that is still being filled */
+				if (pxTraceEventBuffer->uiReserveDepth != 0u)
+				{
+					*ppvData = 0;
+					pxTraceEventBuffer->uiDroppedEvents++;
+
+					return TRC_FAIL;
+				}
+#endif
+
 				/* Free space until there is enough space for a contiguous
 				 * allocation */
 				do
@@ -136,26 +336,37 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 				} while (uiFreeSpace < uiSize);
 
 				/* Calculate slack from the wrapping */
-				pxTraceEventBuffer->uiSlack = uiBufferSize - pxTraceEventBuffer->uiHead;
+				pxTraceEventBuffer->uiSlack = uiBufferSize - uiHead;
 
 				/* Wrap head */
-				pxTraceEventBuffer->uiHead = 0u;
+				uiHead = 0u;
 
 				/* Allocate data */
 				*ppvData = pxTraceEventBuffer->puiBuffer;
 
-				pxTraceEventBuffer->uiNextHead = (pxTraceEventBuffer->uiHead  + uiSize) % uiBufferSize;
+				pxTraceEventBuffer->uiNextHead = TRC_EVENT_BUFFER_WRAP(uiHead + uiSize, uiBufferSize);
 			}
 		}
 		else
 		{
-			uiFreeSpace = pxTraceEventBuffer->uiTail - pxTraceEventBuffer->uiHead - sizeof(uint32_t);
+			uiFreeSpace = pxTraceEventBuffer->uiTail - uiHead - sizeof(uint32_t);
 
 			/* Check if we have to free space */
 			if (uiFreeSpace < uiSize)
 			{
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+				/* Freeing space could evict a reservation that is still being filled */
+				if (pxTraceEventBuffer->uiReserveDepth != 0u)
+				{
+					*ppvData = 0;
+					pxTraceEventBuffer->uiDroppedEvents++;
+
+					return TRC_FAIL;
+				}
+#endif
+
 				/* Check if this is a wrapping alloc */
-				if ((pxTraceEventBuffer->uiSize - pxTraceEventBuffer->uiHead) < uiSize)
+				if ((pxTraceEventBuffer->uiSize - uiHead) < uiSize)
 				{
 					/* To avoid uiHead and uiTail from becoming the same we want to
 					 * pop any events that would make uiTail equal uiHead before
@@ -165,35 +376,44 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 						(void)prvTraceEventBufferAllocPop(pxTraceEventBuffer);
 					} while (pxTraceEventBuffer->uiTail == 0u);
 
-					pxTraceEventBuffer->uiSlack = pxTraceEventBuffer->uiSize - pxTraceEventBuffer->uiHead;
-					pxTraceEventBuffer->uiHead = 0u;
+					pxTraceEventBuffer->uiSlack = pxTraceEventBuffer->uiSize - uiHead;
+					uiHead = 0u;
 				}
 				
 				do
 				{
 					(void)prvTraceEventBufferAllocPop(pxTraceEventBuffer);
-					uiFreeSpace = pxTraceEventBuffer->uiTail - pxTraceEventBuffer->uiHead - sizeof(uint32_t);
+					uiFreeSpace = pxTraceEventBuffer->uiTail - uiHead - sizeof(uint32_t);
 				} while (uiFreeSpace < uiSize);
 
 				if (pxTraceEventBuffer->uiTail == 0u)
 				{
-					*ppvData = &pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+					*ppvData = &pxTraceEventBuffer->puiBuffer[uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 				}
 			}
 
 			/* Alloc data */
-			*ppvData = &pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+			*ppvData = &pxTraceEventBuffer->puiBuffer[uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
-			pxTraceEventBuffer->uiNextHead = (pxTraceEventBuffer->uiHead + uiSize);
+			pxTraceEventBuffer->uiNextHead = (uiHead + uiSize);
 		}
+
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+		/* Blocks in the slack area start with the event at the start of the buffer */
+		if (uiHead != uiAllocHead)
+		{
+			prvTraceEventBufferIndexBlocks(pxTraceEventBuffer, uiAllocHead, uiBufferSize);
+		}
+
+		prvTraceEventBufferIndexBlocks(pxTraceEventBuffer, uiHead, uiHead + uiSize);
+#endif
 	}
 	else
 	{
 		/* Since a consumer could potentially update tail (free) during the procedure
 		 * we have to save it here to avoid problems with it changing during this call.
 		 */
-		uiHead = pxTraceEventBuffer->uiHead;
-		uiTail = pxTraceEventBuffer->uiTail;
+		uiTail = prvTraceEventBufferLoadAcquire(&pxTraceEventBuffer->uiTail);
 
 		if (uiHead >= uiTail)
 		{
@@ -202,6 +422,7 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 			if (uiFreeSpace < uiSize)
 			{
 				*ppvData = 0;
+				pxTraceEventBuffer->uiDroppedEvents++;
 
 				return TRC_FAIL;
 			}
@@ -209,17 +430,19 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 			/* Copy data */
 			if ((uiBufferSize - uiHead) > uiSize)
 			{
-				*ppvData = &pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+				*ppvData = &pxTraceEventBuffer->puiBuffer[uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
-				pxTraceEventBuffer->uiNextHead = (uiHead + uiSize) % uiBufferSize;
+				pxTraceEventBuffer->uiNextHead = TRC_EVENT_BUFFER_WRAP(uiHead + uiSize, uiBufferSize);
 			}
 			else
 			{
 				uiFreeSpace = uiTail;
 
-				if (uiFreeSpace < uiSize)
+				/* The head must not catch up with the tail, since that would make the buffer look empty */
+				if (uiFreeSpace <= uiSize)
 				{
 					*ppvData = 0;
+					pxTraceEventBuffer->uiDroppedEvents++;
 
 					return TRC_FAIL;
 				}
@@ -229,7 +452,7 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 
 				*ppvData = pxTraceEventBuffer->puiBuffer;
 
-				pxTraceEventBuffer->uiNextHead = (uiHead + pxTraceEventBuffer->uiSlack + uiSize) % uiBufferSize;
+				pxTraceEventBuffer->uiNextHead = TRC_EVENT_BUFFER_WRAP(uiHead + pxTraceEventBuffer->uiSlack + uiSize, uiBufferSize);
 			}
 		}
 		else
@@ -239,29 +462,60 @@ traceResult xTraceEventBufferAlloc(TraceEventBuffer_t *pxTraceEventBuffer, uint3
 			if (uiFreeSpace < uiSize)
 			{
 				*ppvData = 0;
+				pxTraceEventBuffer->uiDroppedEvents++;
 
 				return TRC_FAIL;
 			}
 
 			/* Alloc data */
-			*ppvData = &pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+			*ppvData = &pxTraceEventBuffer->puiBuffer[uiHead]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
 			pxTraceEventBuffer->uiNextHead = (uiHead + uiSize);
 		}
 	}
 
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+	pxTraceEventBuffer->uiReserveDepth++;
+#endif
+
 	return TRC_SUCCESS;
 }
 
 traceResult xTraceEventBufferAllocCommit(TraceEventBuffer_t *pxTraceEventBuffer, const void *pvData, uint32_t uiSize, int32_t *piBytesWritten)
 {
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+	TRACE_ALLOC_CRITICAL_SECTION();
+#endif
+
 	(void)pvData;
 
 	/* This should never fail */
 	TRC_ASSERT_ALWAYS_EVALUATE(xTraceTimestampGetWraparounds(&pxTraceEventBuffer->uiTimerWraparounds) == TRC_SUCCESS);
 
-	/* Advance head location */
-	pxTraceEventBuffer->uiHead = pxTraceEventBuffer->uiNextHead;
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+	/* The commit is made outside of the event's critical section and may be
+	 * preempted by other reservations and commits, so the depth and head are
+	 * updated with interrupts masked. */
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(pxTraceEventBuffer->uiReserveDepth != 0u);
+
+	/* The last outstanding reservation publishes everything up to the
+	 * reservation head, all other commits only decrease the depth and are
+	 * published along with it. */
+	if (pxTraceEventBuffer->uiReserveDepth == 1u)
+	{
+		prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiHead, pxTraceEventBuffer->uiNextHead);
+	}
+
+	pxTraceEventBuffer->uiReserveDepth--;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+#else
+	/* Advance head location, the consumer may read the event as soon as it is updated */
+	prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiHead, pxTraceEventBuffer->uiNextHead);
+#endif
 
 	/* Update bytes written */
 	*piBytesWritten = (int32_t)uiSize;
@@ -331,7 +585,11 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 
 			pxTraceEventBuffer->uiFree -= uiSize;
 
-			pxTraceEventBuffer->uiHead = (uiHead + uiSize) % uiBufferSize;
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+			prvTraceEventBufferIndexBlocks(pxTraceEventBuffer, uiHead, uiHead + uiSize);
+#endif
+
+			pxTraceEventBuffer->uiHead = TRC_EVENT_BUFFER_WRAP(uiHead + uiSize, uiBufferSize);
 
 			*piBytesWritten = (int32_t)uiSize;
 			break;
@@ -340,7 +598,7 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 			 * we have to save it here to avoid problems with the push algorithm.
 			 */
 			uiHead = pxTraceEventBuffer->uiHead;
-			uiTail = pxTraceEventBuffer->uiTail;
+			uiTail = prvTraceEventBufferLoadAcquire(&pxTraceEventBuffer->uiTail);
 
 			if (uiHead >= uiTail)
 			{
@@ -349,6 +607,7 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 				if (uiFreeSpace < uiSize)
 				{
 					*piBytesWritten = 0;
+					pxTraceEventBuffer->uiDroppedEvents++;
 
 					return TRC_SUCCESS;
 				}
@@ -364,7 +623,7 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 					TRC_MEMCPY(pxTraceEventBuffer->puiBuffer, (void*)(&((uint8_t*)pvData)[(uiBufferSize - uiHead)]), (uiSize - (uiBufferSize - uiHead)));  /*cstat !MISRAC2012-Rule-11.5 Suppress pointer checks*/ /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 				}
 
-				pxTraceEventBuffer->uiHead = (uiHead + uiSize) % uiBufferSize;
+				prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiHead, TRC_EVENT_BUFFER_WRAP(uiHead + uiSize, uiBufferSize));
 			}
 			else
 			{
@@ -373,6 +632,7 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 				if (uiFreeSpace < uiSize)
 				{
 					*piBytesWritten = 0;
+					pxTraceEventBuffer->uiDroppedEvents++;
 
 					return TRC_SUCCESS;
 				}
@@ -380,7 +640,7 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 				/* Copy data */
 				TRC_MEMCPY(&pxTraceEventBuffer->puiBuffer[pxTraceEventBuffer->uiHead], pvData, uiSize); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
-				pxTraceEventBuffer->uiHead = (uiHead + uiSize);
+				prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiHead, uiHead + uiSize);
 			}
 
 			*piBytesWritten = (int32_t)uiSize;
@@ -389,6 +649,11 @@ traceResult xTraceEventBufferPush(TraceEventBuffer_t *pxTraceEventBuffer, void *
 			return TRC_FAIL;
 	}
 
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+	/* Pushed data is committed directly, keep the reservation head in sync */
+	pxTraceEventBuffer->uiNextHead = pxTraceEventBuffer->uiHead;
+#endif
+
 	return TRC_SUCCESS;
 }
 
@@ -406,7 +671,8 @@ traceResult xTraceEventBufferTransferAll(TraceEventBuffer_t* pxTraceEventBuffer,
 	/* This should never fail */
 	TRC_ASSERT(piBytesWritten != (void*)0);
 
-	uiHead = pxTraceEventBuffer->uiHead;
+	/* The producer publishes uiSlack and the event data before uiHead */
+	uiHead = prvTraceEventBufferLoadAcquire(&pxTraceEventBuffer->uiHead);
 	uiTail = pxTraceEventBuffer->uiTail;
 	uiSlack = pxTraceEventBuffer->uiSlack;
 
@@ -436,7 +702,8 @@ traceResult xTraceEventBufferTransferAll(TraceEventBuffer_t* pxTraceEventBuffer,
 		if ((uint32_t)iBytesWritten == (pxTraceEventBuffer->uiSize - uiTail - uiSlack))
 		{
 			/* uiTail is moved to start of buffer */
-			pxTraceEventBuffer->uiTail = 0u;
+			uiTail = 0u;
+			prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, uiTail);
 
 			iSumBytesWritten = iBytesWritten;
 
@@ -450,8 +717,8 @@ traceResult xTraceEventBufferTransferAll(TraceEventBuffer_t* pxTraceEventBuffer,
 		}
 	}
 	
-	/* Move tail */
-	pxTraceEventBuffer->uiTail += (uint32_t)iBytesWritten;
+	/* Move tail, the written data may be overwritten as soon as it is updated */
+	prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, uiTail + (uint32_t)iBytesWritten);
 	
 	iSumBytesWritten += iBytesWritten;
 
@@ -474,7 +741,8 @@ traceResult xTraceEventBufferTransferChunk(TraceEventBuffer_t* pxTraceEventBuffe
 	/* This should never fail */
 	TRC_ASSERT(piBytesWritten != (void*)0);
 
-	uiHead = pxTraceEventBuffer->uiHead;
+	/* The producer publishes uiSlack and the event data before uiHead */
+	uiHead = prvTraceEventBufferLoadAcquire(&pxTraceEventBuffer->uiHead);
 	uiTail = pxTraceEventBuffer->uiTail;
 	uiSlack = pxTraceEventBuffer->uiSlack;
 
@@ -498,7 +766,7 @@ traceResult xTraceEventBufferTransferChunk(TraceEventBuffer_t* pxTraceEventBuffe
 
 		(void)xTraceStreamPortWriteData(&pxTraceEventBuffer->puiBuffer[uiTail], uiBytesToWrite, uiCoreId, &iBytesWritten); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
 
-		pxTraceEventBuffer->uiTail += (uint32_t)iBytesWritten;
+		prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, uiTail + (uint32_t)iBytesWritten);
 	}
 	else
 	{
@@ -515,11 +783,11 @@ traceResult xTraceEventBufferTransferChunk(TraceEventBuffer_t* pxTraceEventBuffe
 		 * segment, reset tail to 0. */
 		if ((uiTail + (uint32_t)iBytesWritten) == (pxTraceEventBuffer->uiSize - uiSlack))
 		{
-			pxTraceEventBuffer->uiTail = 0u;
+			prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, 0u);
 		}
 		else
 		{
-			pxTraceEventBuffer->uiTail += (uint32_t)iBytesWritten;
+			prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, uiTail + (uint32_t)iBytesWritten);
 		}
 	}
 
@@ -528,6 +796,50 @@ traceResult xTraceEventBufferTransferChunk(TraceEventBuffer_t* pxTraceEventBuffe
 	return TRC_SUCCESS;
 }
 
+traceResult xTraceEventBufferPeek(TraceEventBuffer_t* pxTraceEventBuffer, void** ppvData, uint32_t* puiSize)
+{
+	uint32_t uiHead;
+	uint32_t uiTail;
+	uint32_t uiSlack;
+
+	/* This should never fail */
+	TRC_ASSERT(pxTraceEventBuffer != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(ppvData != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(puiSize != (void*)0);
+
+	/* The producer publishes uiSlack and the event data before uiHead */
+	uiHead = prvTraceEventBufferLoadAcquire(&pxTraceEventBuffer->uiHead);
+	uiTail = pxTraceEventBuffer->uiTail;
+	uiSlack = pxTraceEventBuffer->uiSlack;
+
+	/* Move tail to the start of the buffer if everything up to the slack has been released */
+	if ((uiHead < uiTail) && (uiTail >= (pxTraceEventBuffer->uiSize - uiSlack)))
+	{
+		uiTail = 0u;
+		prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, uiTail);
+	}
+
+	*ppvData = &pxTraceEventBuffer->puiBuffer[uiTail]; /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+	*puiSize = (uiHead >= uiTail) ? (uiHead - uiTail) : (pxTraceEventBuffer->uiSize - uiSlack - uiTail);
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceEventBufferRelease(TraceEventBuffer_t* pxTraceEventBuffer, uint32_t uiSize)
+{
+	/* This should never fail */
+	TRC_ASSERT(pxTraceEventBuffer != (void*)0);
+
+	/* The released data may be overwritten as soon as tail is updated */
+	prvTraceEventBufferStoreRelease(&pxTraceEventBuffer->uiTail, pxTraceEventBuffer->uiTail + uiSize);
+
+	return TRC_SUCCESS;
+}
+
 traceResult xTraceEventBufferClear(TraceEventBuffer_t* pxTraceEventBuffer)
 {
 	/* This should never fail */
@@ -538,6 +850,14 @@ traceResult xTraceEventBufferClear(TraceEventBuffer_t* pxTraceEventBuffer)
 	pxTraceEventBuffer->uiFree = pxTraceEventBuffer->uiSize;
 	pxTraceEventBuffer->uiSlack = 0u;
 	pxTraceEventBuffer->uiNextHead = 0u;
+	pxTraceEventBuffer->uiDroppedEvents = 0u;
+
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	if (pxTraceEventBuffer->uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
+	{
+		TRC_EVENT_BUFFER_BLOCK_INDEX(pxTraceEventBuffer)[0] = 0u;
+	}
+#endif
 
 	return TRC_SUCCESS;
 }
@@ -18,6 +18,147 @@
 
 static TraceMultiCoreEventBuffer_t *pxInternalEventBuffer TRC_CFG_RECORDER_DATA_ATTRIBUTE;
 
+#if (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED)
+static TraceMultiCoreEventBufferMerge_t xInternalEventBufferMerge TRC_CFG_RECORDER_DATA_ATTRIBUTE;
+
+#define TRC_INTERNAL_BUFFER_MERGE_RESET() (void)memset(&xInternalEventBufferMerge, 0, sizeof(xInternalEventBufferMerge))
+#else
+#define TRC_INTERNAL_BUFFER_MERGE_RESET()
+#endif
+
+#if (TRC_INTERNAL_BUFFER_USE_CTRL_TASK_WAKEUP == 1)
+
+#define TRC_INTERNAL_BUFFER_WAKEUP_IDLE 0u
+#define TRC_INTERNAL_BUFFER_WAKEUP_REQUESTED 1u
+#define TRC_INTERNAL_BUFFER_WAKEUP_SENT 2u
+
+/* Requested when the buffer fills up, sent once the kernel port has notified the TzCtrl task and
+ * idle again when the TzCtrl task transfers the data */
+static volatile uint32_t uiCtrlTaskWakeup = TRC_INTERNAL_BUFFER_WAKEUP_IDLE;
+
+/* Requests a TzCtrl wakeup when the event buffer of this core has filled up to
+ * TRC_CFG_CTRL_TASK_WAKEUP_LEVEL percent, instead of waiting for the next period.
+ * This is reached from kernel hooks, where the kernel must not be called, so the
+ * notification itself is left to xTraceInternalEventBufferNotifyCtrlTask().
+ * Called after each commit, which with TRC_CFG_USE_EVENT_BUFFER_RESERVATION is
+ * made outside of the event's critical section, so one is taken here. */
+static void prvTraceInternalEventBufferCheckLevel(void)
+{
+	const TraceEventBuffer_t* pxEventBuffer;
+	uint32_t uiHead;
+	uint32_t uiTail;
+	uint32_t uiUsed;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	if (uiCtrlTaskWakeup == TRC_INTERNAL_BUFFER_WAKEUP_IDLE)
+	{
+		pxEventBuffer = pxInternalEventBuffer->xEventBuffer[TRC_CFG_GET_CURRENT_CORE()];
+		uiHead = pxEventBuffer->uiHead;
+		uiTail = pxEventBuffer->uiTail;
+
+		/* Any slack at the end of the buffer is counted as used */
+		uiUsed = (uiHead >= uiTail) ? (uiHead - uiTail) : (pxEventBuffer->uiSize - uiTail + uiHead);
+
+		if (uiUsed >= (pxEventBuffer->uiSize / 100u) * (uint32_t)(TRC_CFG_CTRL_TASK_WAKEUP_LEVEL))
+		{
+			uiCtrlTaskWakeup = TRC_INTERNAL_BUFFER_WAKEUP_REQUESTED;
+		}
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+}
+
+traceResult xTraceInternalEventBufferNotifyCtrlTask(void)
+{
+	uint32_t uiNotify = 0u;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* Called on every OS tick, so the common case is kept short */
+	if (uiCtrlTaskWakeup != TRC_INTERNAL_BUFFER_WAKEUP_REQUESTED)
+	{
+		return TRC_SUCCESS;
+	}
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	if (uiCtrlTaskWakeup == TRC_INTERNAL_BUFFER_WAKEUP_REQUESTED)
+	{
+		uiCtrlTaskWakeup = TRC_INTERNAL_BUFFER_WAKEUP_SENT;
+		uiNotify = 1u;
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	/* The kernel is called outside of the trace critical section */
+	if (uiNotify == 0u)
+	{
+		return TRC_SUCCESS;
+	}
+
+	return xTraceKernelPortNotifyCtrlTask();
+}
+
+#define TRC_INTERNAL_BUFFER_CHECK_LEVEL() prvTraceInternalEventBufferCheckLevel()
+#define TRC_INTERNAL_BUFFER_WAKEUP_DONE() (uiCtrlTaskWakeup = TRC_INTERNAL_BUFFER_WAKEUP_IDLE)
+
+#else
+
+#define TRC_INTERNAL_BUFFER_CHECK_LEVEL()
+#define TRC_INTERNAL_BUFFER_WAKEUP_DONE()
+
+#endif
+
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+
+/* uiInFlight value for a write that was started before the buffer was cleared */
+#define TRC_INTERNAL_BUFFER_WRITE_DISCARDED 0xFFFFFFFFUL
+
+/* Bytes of each core's buffer that the stream port is sending, released on completion */
+static volatile uint32_t auiInternalEventBufferInFlight[TRC_CFG_CORE_COUNT] TRC_CFG_RECORDER_DATA_ATTRIBUTE;
+
+/* Starts sending the oldest data of a core, unless a write is already in flight */
+static void prvTraceInternalEventBufferStartWrite(uint32_t uiCoreId)
+{
+	void* pvData = (void*)0;
+	uint32_t uiSize = 0u;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* Both the TzCtrl task and the completion interrupt start writes */
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	if (auiInternalEventBufferInFlight[uiCoreId] == 0u)
+	{
+		(void)xTraceEventBufferPeek(pxInternalEventBuffer->xEventBuffer[uiCoreId], &pvData, &uiSize);
+
+#if (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_CHUNKED)
+		if (uiSize > (uint32_t)(TRC_INTERNAL_BUFFER_CHUNK_SIZE))
+		{
+			uiSize = (uint32_t)(TRC_INTERNAL_BUFFER_CHUNK_SIZE);
+		}
+#endif
+
+		if (uiSize > 0u)
+		{
+			auiInternalEventBufferInFlight[uiCoreId] = uiSize;
+
+			if (xTraceStreamPortWriteDataAsync(pvData, uiSize, uiCoreId) == TRC_FAIL)
+			{
+				/* The stream port is busy, try again later */
+				auiInternalEventBufferInFlight[uiCoreId] = 0u;
+			}
+		}
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+}
+
+#endif
+
 traceResult xTraceInternalEventBufferInitialize(TraceInternalEventBufferData_t* pxBuffer)
 {
 	/* sizeof(TraceInternalEventBufferData_t) must be larger than sizeof(TraceMultiCoreEventBuffer_t) or there will be no room for any data */
@@ -35,6 +176,12 @@ traceResult xTraceInternalEventBufferInitialize(TraceInternalEventBufferData_t*
 		return TRC_FAIL;
 	}
 
+	TRC_INTERNAL_BUFFER_MERGE_RESET();
+
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+	(void)memset((void*)auiInternalEventBufferInFlight, 0, sizeof(auiInternalEventBufferInFlight));
+#endif
+
 	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER);
 
 	return TRC_SUCCESS;
@@ -50,20 +197,32 @@ traceResult xTraceInternalEventBufferAlloc(uint32_t uiSize, void **ppvData)
 
 traceResult xTraceInternalEventBufferAllocCommit(void *pvData, uint32_t uiSize, int32_t *piBytesWritten)
 {
+	traceResult xResult;
+
 	(void)pvData;
 
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
 
-	return xTraceMultiCoreEventBufferAllocCommit(pxInternalEventBuffer, pvData, uiSize, piBytesWritten);
+	xResult = xTraceMultiCoreEventBufferAllocCommit(pxInternalEventBuffer, pvData, uiSize, piBytesWritten);
+
+	TRC_INTERNAL_BUFFER_CHECK_LEVEL();
+
+	return xResult;
 }
 
 traceResult xTraceInternalEventBufferPush(void *pvData, uint32_t uiSize, int32_t *piBytesWritten)
 {
+	traceResult xResult;
+
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
 	
-	return xTraceMultiCoreEventBufferPush(pxInternalEventBuffer, pvData, uiSize, piBytesWritten);
+	xResult = xTraceMultiCoreEventBufferPush(pxInternalEventBuffer, pvData, uiSize, piBytesWritten);
+
+	TRC_INTERNAL_BUFFER_CHECK_LEVEL();
+
+	return xResult;
 }
 
 traceResult xTraceInternalEventBufferTransferAll(void)
@@ -73,6 +232,9 @@ traceResult xTraceInternalEventBufferTransferAll(void)
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
 
+	/* Events committed from now on may notify the TzCtrl task again */
+	TRC_INTERNAL_BUFFER_WAKEUP_DONE();
+
 	return xTraceMultiCoreEventBufferTransferAll(pxInternalEventBuffer, &iBytesWritten);
 }
 
@@ -84,6 +246,9 @@ traceResult xTraceInternalEventBufferTransferChunk(void)
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
 
+	/* Events committed from now on may notify the TzCtrl task again */
+	TRC_INTERNAL_BUFFER_WAKEUP_DONE();
+
 	do
 	{
 		if (xTraceMultiCoreEventBufferTransferChunk(pxInternalEventBuffer, TRC_INTERNAL_BUFFER_CHUNK_SIZE, &iBytesWritten) == TRC_FAIL)
@@ -98,10 +263,120 @@ traceResult xTraceInternalEventBufferTransferChunk(void)
 	return TRC_SUCCESS;
 }
 
+#if (TRC_INTERNAL_EVENT_BUFFER_TRANSFER_MODE == TRC_INTERNAL_EVENT_BUFFER_OPTION_TRANSFER_MODE_MERGED)
+traceResult xTraceInternalEventBufferTransferMerged(void)
+{
+	int32_t iBytesWritten = 0;
+	int32_t iCounter = 0;
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
+
+	/* Events committed from now on may notify the TzCtrl task again */
+	TRC_INTERNAL_BUFFER_WAKEUP_DONE();
+
+	do
+	{
+		if (xTraceMultiCoreEventBufferTransferMerged(pxInternalEventBuffer, &xInternalEventBufferMerge, TRC_INTERNAL_BUFFER_CHUNK_SIZE, &iBytesWritten) == TRC_FAIL)
+		{
+			return TRC_FAIL;
+		}
+
+		iCounter++;
+		/* Same limits as for chunked transfers */
+	} while (iBytesWritten >= (int32_t)(TRC_INTERNAL_BUFFER_CHUNK_TRANSFER_AGAIN_SIZE_LIMIT) && iCounter < (int32_t)(TRC_INTERNAL_BUFFER_CHUNK_TRANSFER_AGAIN_COUNT_LIMIT));
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceInternalEventBufferMarkRaw(uint32_t uiSize)
+{
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
+
+	/* This should never fail */
+	TRC_ASSERT((TRC_CFG_GET_CURRENT_CORE()) < (TRC_CFG_CORE_COUNT));
+
+	xInternalEventBufferMerge.uiPendingBytes[TRC_CFG_GET_CURRENT_CORE()] += uiSize;
+
+	return TRC_SUCCESS;
+}
+#endif
+
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+traceResult xTraceInternalEventBufferTransferAsync(void)
+{
+	uint32_t uiCoreId;
+
+	/* This should never fail */
+	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
+
+	/* Events committed from now on may notify the TzCtrl task again */
+	TRC_INTERNAL_BUFFER_WAKEUP_DONE();
+
+	for (uiCoreId = 0u; uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT); uiCoreId++)
+	{
+		prvTraceInternalEventBufferStartWrite(uiCoreId);
+	}
+
+	return TRC_SUCCESS;
+}
+
+traceResult xTraceInternalEventBufferWriteComplete(uint32_t uiChannel, uint32_t uiBytesWritten)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* This should never fail */
+	TRC_ASSERT(uiChannel < (uint32_t)(TRC_CFG_CORE_COUNT));
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	/* Nothing is released for data from before the buffer was cleared */
+	if (auiInternalEventBufferInFlight[uiChannel] != TRC_INTERNAL_BUFFER_WRITE_DISCARDED)
+	{
+		/* This should never fail */
+		TRC_ASSERT(uiBytesWritten <= auiInternalEventBufferInFlight[uiChannel]);
+
+		(void)xTraceEventBufferRelease(pxInternalEventBuffer->xEventBuffer[uiChannel], uiBytesWritten);
+	}
+
+	auiInternalEventBufferInFlight[uiChannel] = 0u;
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	/* A failed write is retried by the TzCtrl task rather than from the interrupt */
+	if (uiBytesWritten > 0u)
+	{
+		prvTraceInternalEventBufferStartWrite(uiChannel);
+	}
+
+	return TRC_SUCCESS;
+}
+#endif
+
 traceResult xTraceInternalEventBufferClear()
 {
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+	uint32_t uiCoreId;
+#endif
+
 	/* This should never fail */
 	TRC_ASSERT(xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_INTERNAL_EVENT_BUFFER));
+
+	TRC_INTERNAL_BUFFER_WAKEUP_DONE();
+
+	TRC_INTERNAL_BUFFER_MERGE_RESET();
+
+#ifdef TRC_STREAM_PORT_ASYNC_WRITE_SUPPORT
+	/* The space of writes in flight must not be released into the new session */
+	for (uiCoreId = 0u; uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT); uiCoreId++)
+	{
+		if (auiInternalEventBufferInFlight[uiCoreId] != 0u)
+		{
+			auiInternalEventBufferInFlight[uiCoreId] = TRC_INTERNAL_BUFFER_WRITE_DISCARDED;
+		}
+	}
+#endif
 	
 	return xTraceMultiCoreEventBufferClear(pxInternalEventBuffer);
 }
@@ -12,10 +12,46 @@
 
 #if (TRC_USE_TRACEALYZER_RECORDER == 1)
 
+/**
+ * @internal Returns the size of the event buffer placed after the TraceEventBuffer_t in a core's part of the buffer.
+ */
+static uint32_t prvTraceMultiCoreEventBufferGetEventBufferSize(uint32_t uiOptions, uint32_t uiBufferSizePerCore)
+{
+	uint32_t uiEventBufferSize = uiBufferSizePerCore - sizeof(TraceEventBuffer_t);
+
+	(void)uiOptions;
+
+#if (TRC_CFG_EVENT_BUFFER_POW2_SIZE == 1)
+#if (TRC_CFG_EVENT_BUFFER_BLOCK_SIZE > 0)
+	if (uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
+	{
+		/* Only the event data needs to be a power of two, not the block index following it */
+		uiEventBufferSize = (uiEventBufferSize / ((uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE) + (uint32_t)sizeof(uint32_t))) * (uint32_t)(TRC_CFG_EVENT_BUFFER_BLOCK_SIZE);
+	}
+#endif
+
+	/* Round down to the largest power of two that fits, the rest of the per-core space is left unused */
+	while ((uiEventBufferSize & (uiEventBufferSize - 1u)) != 0u)
+	{
+		uiEventBufferSize &= uiEventBufferSize - 1u;
+	}
+
+	if (uiOptions == TRC_EVENT_BUFFER_OPTION_OVERWRITE)
+	{
+		uiEventBufferSize += TRC_EVENT_BUFFER_BLOCK_INDEX_SIZE(uiEventBufferSize);
+	}
+#endif
+
+	return uiEventBufferSize;
+}
+
 traceResult xTraceMultiCoreEventBufferInitialize(TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer, uint32_t uiOptions,
 	uint8_t* puiBuffer, uint32_t uiSize)
 {
+	static const uint32_t auiCoreWeights[TRC_CFG_CORE_COUNT] = TRC_CFG_EVENT_BUFFER_CORE_WEIGHTS;
 	uint32_t i;
+	uint32_t uiWeightSum = 0u;
+	uint32_t uiOffset = 0u;
 	uint32_t uiBufferSizePerCore;
 
 	/* This should never fail */
@@ -24,25 +60,45 @@ traceResult xTraceMultiCoreEventBufferInitialize(TraceMultiCoreEventBuffer_t* co
 	/* This should never fail */
 	TRC_ASSERT(puiBuffer != (void*)0);
 
-	uiBufferSizePerCore = ((uiSize / (uint32_t)(TRC_CFG_CORE_COUNT)) / sizeof(TraceUnsignedBaseType_t)) * sizeof(TraceUnsignedBaseType_t); /* BaseType aligned */
-
-	/* This should never fail */
-	TRC_ASSERT(uiBufferSizePerCore != 0u);
+	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
+	{
+		uiWeightSum += auiCoreWeights[i];
+	}
 
 	for (i = 0u; i < (uint32_t)(TRC_CFG_CORE_COUNT); i++)
 	{
+		if (uiWeightSum == 0u)
+		{
+			/* No weights configured, split the buffer evenly */
+			uiBufferSizePerCore = uiSize / (uint32_t)(TRC_CFG_CORE_COUNT);
+		}
+		else
+		{
+			/* This should never fail */
+			TRC_ASSERT(auiCoreWeights[i] != 0u);
+
+			uiBufferSizePerCore = (uiSize / uiWeightSum) * auiCoreWeights[i];
+		}
+
+		uiBufferSizePerCore = (uiBufferSizePerCore / sizeof(TraceUnsignedBaseType_t)) * sizeof(TraceUnsignedBaseType_t); /* BaseType aligned */
+
+		/* This should never fail */
+		TRC_ASSERT(uiBufferSizePerCore > sizeof(TraceEventBuffer_t));
+
 		/* Set the event buffer pointers to point into the allocated space we have been given, this ensures
 		 * a flat memory layout necessary for usage in streaming snaphot. */
-		pxTraceMultiCoreEventBuffer->xEventBuffer[i] = (TraceEventBuffer_t*)(&puiBuffer[i * uiBufferSizePerCore]); /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/ /*cstat !MISRAC2004-17.4_b We need to access a spcific point in the buffer*/
+		pxTraceMultiCoreEventBuffer->xEventBuffer[i] = (TraceEventBuffer_t*)(&puiBuffer[uiOffset]); /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/ /*cstat !MISRAC2004-17.4_b We need to access a spcific point in the buffer*/
 
 		/* Initialize the event buffer structure with its memory buffer placed following its own structure data. */
 		/* We need to check this */
 		if (xTraceEventBufferInitialize(pxTraceMultiCoreEventBuffer->xEventBuffer[i], uiOptions,
-			&puiBuffer[(i * uiBufferSizePerCore) + sizeof(TraceEventBuffer_t)], /*cstat !MISRAC2004-17.4_b We need to access a specific point in the buffer*/
-			uiBufferSizePerCore - sizeof(TraceEventBuffer_t)) == TRC_FAIL)
+			&puiBuffer[uiOffset + sizeof(TraceEventBuffer_t)], /*cstat !MISRAC2004-17.4_b We need to access a specific point in the buffer*/
+			prvTraceMultiCoreEventBufferGetEventBufferSize(uiOptions, uiBufferSizePerCore)) == TRC_FAIL)
 		{
 			return TRC_FAIL;
 		}
+
+		uiOffset += uiBufferSizePerCore;
 	}
 
 	return TRC_SUCCESS;
@@ -61,6 +117,7 @@ traceResult xTraceMultiCoreEventBufferAlloc(const TraceMultiCoreEventBuffer_t *
 	return xTraceEventBufferAlloc(pxTraceMultiCoreEventBuffer->xEventBuffer[TRC_CFG_GET_CURRENT_CORE()], uiSize, ppvData);
 }
 
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 0)
 /*cstat !MISRAC2012-Rule-5.1 Yes, these are long names*/
 traceResult xTraceMultiCoreEventBufferAllocCommit(const TraceMultiCoreEventBuffer_t * const pxTraceMultiCoreEventBuffer, void *pvData, uint32_t uiSize, int32_t *piBytesWritten)
 {
@@ -71,6 +128,7 @@ traceResult xTraceMultiCoreEventBufferAllocCommit(const TraceMultiCoreEventBuffe
 
 	return xTraceEventBufferAllocCommit(pxTraceMultiCoreEventBuffer->xEventBuffer[TRC_CFG_GET_CURRENT_CORE()], pvData, uiSize, piBytesWritten);
 }
+#endif
 
 traceResult xTraceMultiCoreEventBufferPush(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer,
 	void* pvData, uint32_t uiSize, int32_t* piBytesWritten)
@@ -85,6 +143,35 @@ traceResult xTraceMultiCoreEventBufferPush(const TraceMultiCoreEventBuffer_t* co
 
 #endif
 
+#if (TRC_CFG_USE_EVENT_BUFFER_RESERVATION == 1)
+/*cstat !MISRAC2012-Rule-5.1 Yes, these are long names*/
+traceResult xTraceMultiCoreEventBufferAllocCommit(const TraceMultiCoreEventBuffer_t * const pxTraceMultiCoreEventBuffer, void *pvData, uint32_t uiSize, int32_t *piBytesWritten)
+{
+	TraceEventBuffer_t* pxEventBuffer = (void*)0;
+	uint32_t uiCoreId;
+
+	/* This should never fail */
+	TRC_ASSERT(pxTraceMultiCoreEventBuffer != (void*)0);
+
+	/* The task may have migrated since the allocation, so the core buffer is
+	 * found from the allocated data rather than from the current core. */
+	for (uiCoreId = 0u; uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT); uiCoreId++)
+	{
+		pxEventBuffer = pxTraceMultiCoreEventBuffer->xEventBuffer[uiCoreId];
+
+		if (((uint8_t*)pvData >= pxEventBuffer->puiBuffer) && ((uint8_t*)pvData < &pxEventBuffer->puiBuffer[pxEventBuffer->uiSize])) /*cstat !MISRAC2004-17.4_b !MISRAC2012-Rule-11.5 We need to compare against the buffer bounds*/
+		{
+			break;
+		}
+	}
+
+	/* This should never fail */
+	TRC_ASSERT(uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT));
+
+	return xTraceEventBufferAllocCommit(pxEventBuffer, pvData, uiSize, piBytesWritten);
+}
+#endif
+
 /*cstat !MISRAC2012-Rule-5.1 Yes, these are long names*/
 traceResult xTraceMultiCoreEventBufferTransferAll(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer, int32_t* piBytesWritten)
 {
@@ -141,6 +228,179 @@ traceResult xTraceMultiCoreEventBufferTransferChunk(const TraceMultiCoreEventBuf
 	return TRC_SUCCESS;
 }
 
+/**
+ * @internal Returns the timestamp of the event at pvEvent. With compact timestamps
+ * it is the delta added to the timestamp of the previous event on the same core,
+ * unless the event is a sync event holding the absolute timestamp.
+ */
+static uint32_t prvTraceMultiCoreEventBufferGetTimestamp(const void* pvEvent, uint32_t uiPreviousTimestamp)
+{
+	const TraceEvent0_t* pxEvent = (const TraceEvent0_t*)pvEvent; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.5 Suppress conversion from pointer to void checks*/
+
+#if (TRC_CFG_USE_COMPACT_TIMESTAMPS == 1)
+	if (((uint32_t)pxEvent->EventID & 0xFFFUL) == (uint32_t)(PSF_EVENT_TS_SYNC))
+	{
+		return (uint32_t)((const TraceEvent2_t*)pvEvent)->uxParams[0]; /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.5 Suppress conversion from pointer to void checks*/
+	}
+
+	return uiPreviousTimestamp + ((uint32_t)pxEvent->TSDelta & (uint32_t)TRC_EVENT_TS_DELTA_MAX);
+#else
+	(void)uiPreviousTimestamp;
+
+	return pxEvent->TS;
+#endif
+}
+
+/*cstat !MISRAC2012-Rule-5.1 Yes, these are long names*/
+traceResult xTraceMultiCoreEventBufferTransferMerged(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer, TraceMultiCoreEventBufferMerge_t* const pxMerge, uint32_t uiChunkSize, int32_t* piBytesWritten)
+{
+	void* apvData[TRC_CFG_CORE_COUNT];
+	uint32_t auiSize[TRC_CFG_CORE_COUNT];
+	uint32_t auiTimestamp[TRC_CFG_CORE_COUNT];
+	uint32_t uiCoreId;
+	uint32_t uiNext;
+	uint32_t uiOther;
+	uint32_t uiBytesToWrite;
+	uint32_t uiBytesLeft;
+	uint32_t uiEventSize;
+	uint32_t uiTimestamp;
+	uint32_t uiEventTimestamp;
+	uint32_t uiTotal = 0u;
+	int32_t iBytesWritten;
+
+	/* This should never fail */
+	TRC_ASSERT(pxTraceMultiCoreEventBuffer != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(pxMerge != (void*)0);
+
+	/* This should never fail */
+	TRC_ASSERT(piBytesWritten != (void*)0);
+
+	*piBytesWritten = 0;
+
+	while (uiTotal < uiChunkSize)
+	{
+		uiNext = (uint32_t)(TRC_CFG_CORE_COUNT);
+		uiOther = (uint32_t)(TRC_CFG_CORE_COUNT);
+
+		/* Find the core with the oldest event, data without event headers goes first */
+		for (uiCoreId = 0u; uiCoreId < (uint32_t)(TRC_CFG_CORE_COUNT); uiCoreId++)
+		{
+			(void)xTraceEventBufferPeek(pxTraceMultiCoreEventBuffer->xEventBuffer[uiCoreId], &apvData[uiCoreId], &auiSize[uiCoreId]);
+
+			if (auiSize[uiCoreId] == 0u)
+			{
+				continue;
+			}
+
+			if (pxMerge->uiPendingBytes[uiCoreId] > 0u)
+			{
+				uiNext = uiCoreId;
+				break;
+			}
+
+			auiTimestamp[uiCoreId] = prvTraceMultiCoreEventBufferGetTimestamp(apvData[uiCoreId], pxMerge->uiTimestamp[uiCoreId]);
+
+			if ((uiNext == (uint32_t)(TRC_CFG_CORE_COUNT)) || ((int32_t)(auiTimestamp[uiCoreId] - auiTimestamp[uiNext]) < 0))
+			{
+				uiOther = uiNext;
+				uiNext = uiCoreId;
+			}
+			else if ((uiOther == (uint32_t)(TRC_CFG_CORE_COUNT)) || ((int32_t)(auiTimestamp[uiCoreId] - auiTimestamp[uiOther]) < 0))
+			{
+				uiOther = uiCoreId;
+			}
+			else
+			{
+				/* Not among the two oldest */
+			}
+		}
+
+		if (uiNext == (uint32_t)(TRC_CFG_CORE_COUNT))
+		{
+			/* All buffers are empty */
+			break;
+		}
+
+		uiBytesLeft = 0u;
+
+		if (pxMerge->uiPendingBytes[uiNext] > 0u)
+		{
+			uiBytesToWrite = pxMerge->uiPendingBytes[uiNext];
+			if (uiBytesToWrite > auiSize[uiNext])
+			{
+				uiBytesToWrite = auiSize[uiNext];
+			}
+			if (uiBytesToWrite > (uiChunkSize - uiTotal))
+			{
+				uiBytesToWrite = uiChunkSize - uiTotal;
+			}
+
+			pxMerge->uiPendingBytes[uiNext] -= uiBytesToWrite;
+			uiTimestamp = pxMerge->uiTimestamp[uiNext];
+		}
+		else
+		{
+			/* Send the events of this core up until one is newer than the oldest event of another core */
+			uiBytesToWrite = 0u;
+			uiTimestamp = pxMerge->uiTimestamp[uiNext];
+
+			while (uiBytesToWrite < auiSize[uiNext])
+			{
+				(void)xTraceEventGetSize(&((uint8_t*)apvData[uiNext])[uiBytesToWrite], &uiEventSize); /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.5 Suppress conversion from pointer to void checks*/ /*cstat !MISRAC2004-17.4_b We need to access a specific point in the buffer*/
+
+				if ((uiEventSize == 0u) || (uiEventSize > (auiSize[uiNext] - uiBytesToWrite)))
+				{
+					/* Not a complete event, the rest of the region is sent as is */
+					uiBytesLeft = auiSize[uiNext] - uiBytesToWrite;
+					break;
+				}
+
+				uiEventTimestamp = prvTraceMultiCoreEventBufferGetTimestamp(&((uint8_t*)apvData[uiNext])[uiBytesToWrite], uiTimestamp); /*cstat !MISRAC2004-11.4 !MISRAC2012-Rule-11.5 Suppress conversion from pointer to void checks*/ /*cstat !MISRAC2004-17.4_b We need to access a specific point in the buffer*/
+
+				if ((uiBytesToWrite > 0u) &&
+					(((uiBytesToWrite + uiEventSize) > (uiChunkSize - uiTotal)) ||
+					((uiOther != (uint32_t)(TRC_CFG_CORE_COUNT)) && ((int32_t)(uiEventTimestamp - auiTimestamp[uiOther]) > 0))))
+				{
+					break;
+				}
+
+				uiBytesToWrite += uiEventSize;
+				uiTimestamp = uiEventTimestamp;
+			}
+
+			if (uiBytesToWrite == 0u)
+			{
+				pxMerge->uiPendingBytes[uiNext] = uiBytesLeft;
+				continue;
+			}
+		}
+
+		iBytesWritten = 0;
+
+		(void)xTraceStreamPortWriteData(apvData[uiNext], uiBytesToWrite, uiNext, &iBytesWritten);
+
+		/* This should never fail */
+		TRC_ASSERT_ALWAYS_EVALUATE(xTraceEventBufferRelease(pxTraceMultiCoreEventBuffer->xEventBuffer[uiNext], (uint32_t)iBytesWritten) == TRC_SUCCESS);
+
+		uiTotal += (uint32_t)iBytesWritten;
+		*piBytesWritten = (int32_t)uiTotal;
+
+		/* The timestamp refers to the end of the run, anything of it not written is sent as is */
+		pxMerge->uiTimestamp[uiNext] = uiTimestamp;
+		pxMerge->uiPendingBytes[uiNext] += (uiBytesToWrite - (uint32_t)iBytesWritten) + uiBytesLeft;
+
+		if ((uint32_t)iBytesWritten < uiBytesToWrite)
+		{
+			/* The stream port didn't accept it all, try again later */
+			break;
+		}
+	}
+
+	return TRC_SUCCESS;
+}
+
 traceResult xTraceMultiCoreEventBufferClear(const TraceMultiCoreEventBuffer_t* const pxTraceMultiCoreEventBuffer)
 {
 	uint32_t uiCoreId;
@@ -18,12 +18,37 @@
 #define TRC_SEND_NAME_ONLY_ON_DELETE 0
 #endif
 
+/* Creates the name event and the object event in one batch */
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static void prvTraceObjectCreateNamedEvent(uint32_t uiEventCode, const char* szName, uint32_t uiNameLength, const TraceUnsignedBaseType_t* const puxParams, uint32_t uiParamCount)
+{
+	TraceEventBatch_t xBatch;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	if (xTraceEventBatchBegin(&xBatch) == TRC_SUCCESS)
+	{
+		/* The first parameter is the object address */
+		(void)xTraceEventBatchAddData(&xBatch, PSF_EVENT_OBJ_NAME, puxParams, 1u, szName, uiNameLength + 1u); /* +1 for termination */
+		(void)xTraceEventBatchAdd(&xBatch, uiEventCode, puxParams, uiParamCount);
+		(void)xTraceEventBatchCommit(&xBatch);
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+}
+
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
 traceResult xTraceObjectRegisterInternal(uint32_t uiEventCode, void* const pvObject, const char* szName, TraceUnsignedBaseType_t uxStateCount, const TraceUnsignedBaseType_t uxStates[], TraceUnsignedBaseType_t uxOptions, TraceObjectHandle_t* pxObjectHandle)
 {
 	TraceEntryHandle_t xEntryHandle;
 	TraceUnsignedBaseType_t i;
 	void *pvAddress;
+#if (TRC_SEND_NAME_ONLY_ON_DELETE == 0)
+	TraceUnsignedBaseType_t auxParams[1u + TRC_ENTRY_TABLE_STATE_COUNT];
+	uint32_t uiLength;
+#endif
 
 	TRACE_ALLOC_CRITICAL_SECTION();
 
@@ -76,9 +101,32 @@ traceResult xTraceObjectRegisterInternal(uint32_t uiEventCode, void* const pvObj
 	if ((szName != (void*)0) && (szName[0] != (char)0)) /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
 	{
 		/* Not a null or empty string */
-		/* This will set the symbol and create an event for it */
+#if (TRC_SEND_NAME_ONLY_ON_DELETE == 0)
+		for (uiLength = 0u; (szName[uiLength] != (char)0) && (uiLength < 128u); uiLength++) {} /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+
+		/* This should never fail */
+		TRC_ASSERT_ALWAYS_EVALUATE(xTraceEntrySetSymbol(xEntryHandle, szName, uiLength) == TRC_SUCCESS);
+
+		if (uxStateCount > (TraceUnsignedBaseType_t)(TRC_ENTRY_TABLE_STATE_COUNT))
+		{
+			return TRC_FAIL;
+		}
+
+		auxParams[0] = (TraceUnsignedBaseType_t)pvAddress;
+		for (i = 0u; i < uxStateCount; i++)
+		{
+			auxParams[i + 1u] = uxStates[i];
+		}
+
+		/* The name and create events are written together */
+		prvTraceObjectCreateNamedEvent(uiEventCode, szName, uiLength, auxParams, (uint32_t)uxStateCount + 1u);
+
+		return TRC_SUCCESS;
+#else
+		/* This will set the symbol, the name event is sent on delete */
 		/* This should never fail */
 		TRC_ASSERT_ALWAYS_EVALUATE(xTraceObjectSetName((TraceObjectHandle_t)xEntryHandle, szName) == TRC_SUCCESS);
+#endif
 	}
 
 	switch (uxStateCount)
@@ -121,6 +169,7 @@ traceResult xTraceObjectUnregister(TraceObjectHandle_t xObjectHandle, uint32_t u
 	void* pvObject = (void*)0;
 	const char *szName = (void*)0; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
 #if (TRC_SEND_NAME_ONLY_ON_DELETE == 1)
+	TraceUnsignedBaseType_t auxParams[2];
 	uint32_t uiLength;
 	uint32_t i;
 #endif
@@ -141,12 +190,15 @@ traceResult xTraceObjectUnregister(TraceObjectHandle_t xObjectHandle, uint32_t u
 
 	uiLength = i;
 
-	/* Send the name event, if possible */
-	(void)xTraceEventCreateData1(PSF_EVENT_OBJ_NAME, (TraceUnsignedBaseType_t)pvObject, (TraceUnsignedBaseType_t*)szName, uiLength + 1); /* +1 for termination */
-#endif /* (TRC_SEND_NAME_ONLY_ON_DELETE == 1) */
+	auxParams[0] = (TraceUnsignedBaseType_t)pvObject; /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6 Suppress conversion from pointer to integer check*/
+	auxParams[1] = uxState;
 
+	/* Send the name and delete events together, if possible */
+	prvTraceObjectCreateNamedEvent(uiEventCode, szName, uiLength, auxParams, 2u);
+#else
 	/* Send the delete event, if possible */
 	(void)xTraceEventCreate2(uiEventCode, (TraceUnsignedBaseType_t)(pvObject), uxState);  /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6 Suppress conversion from pointer to integer check*/
+#endif /* (TRC_SEND_NAME_ONLY_ON_DELETE == 1) */
 
 	return xTraceEntryDelete(xObjectHandle);
 }
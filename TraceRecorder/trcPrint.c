@@ -13,8 +13,19 @@
 #if (TRC_USE_TRACEALYZER_RECORDER == 1) && (TRC_CFG_INCLUDE_USER_EVENTS == 1)
 
 #include <stdarg.h>
+#include <stddef.h>
 
 static traceResult prvTraceVPrintF(const TraceStringHandle_t xChannel, const char* szFormat, uint32_t uiLength, uint32_t uiArgs, va_list* pxVariableList);
+static traceResult prvTraceGetDefaultChannel(TraceStringHandle_t* pxChannel);
+
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+static traceResult prvTracePrintSetChannelLimit(TraceUnsignedBaseType_t uxChannel, uint32_t uiCompact, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate);
+
+#define TRC_PRINT_SUPPRESSED_FORMAT "%u events suppressed"
+
+/* Sized to whole parameters since the event copies the format string parameter by parameter */
+static const char szPrintSuppressedFormat[TRC_ALIGN_CEIL(sizeof(TRC_PRINT_SUPPRESSED_FORMAT), sizeof(TraceUnsignedBaseType_t))] = TRC_PRINT_SUPPRESSED_FORMAT;
+#endif
 
 static TracePrintData_t *pxPrintData TRC_CFG_RECORDER_DATA_ATTRIBUTE;
 
@@ -27,6 +38,9 @@ traceResult xTracePrintInitialize(TracePrintData_t *pxBuffer)
 
 	pxPrintData->defaultChannel = 0;
 	pxPrintData->consoleChannel = 0;
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+	pxPrintData->uxChannelLimitsUsed = 0u;
+#endif
 
 	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_PRINT);
 	
@@ -99,6 +113,13 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
 		return TRC_FAIL;
 	}
 
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+	if (xTracePrintChannelCheck((TraceUnsignedBaseType_t)szChannel) == TRC_FAIL) /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+	{
+		return TRC_SUCCESS;
+	}
+#endif
+
 	if (szFormat == (void*)0)
 	{
 		szFormat = ""; /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
@@ -162,6 +183,182 @@ traceResult xTracePrintCompactF(const char* szChannel, const char* szFormat, ...
 	return xResult;
 }
 
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-16.1 Suppress variable parameter count check*/
+traceResult xTracePrintCompactTypedF(const char* szChannel, const char* szFormat, ...)
+{
+	uint32_t i;
+	uint32_t uiArgs = 0u;
+	uint32_t uiDescriptor = 0u;
+	uint32_t uiType;
+	uint32_t uiOffset = 0u;
+	uint32_t uiLong;
+	uint32_t uiValue;
+	uint64_t ulValue;
+	double dValue;
+	char cSpecifier;
+	va_list xVariableList; /*cstat !MISRAC2012-Rule-17.1 Suppress stdarg usage check*/
+	TraceUnsignedBaseType_t auxPayload[(TRC_PRINT_TYPED_MAX_ARGS * sizeof(uint64_t)) / sizeof(TraceUnsignedBaseType_t)];
+	uint8_t* const puiPayload = (uint8_t*)auxPayload;
+
+	/* We need to check this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_FAIL;
+	}
+
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+	if (xTracePrintChannelCheck((TraceUnsignedBaseType_t)szChannel) == TRC_FAIL) /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+	{
+		return TRC_SUCCESS;
+	}
+#endif
+
+	if (szFormat == (void*)0)
+	{
+		szFormat = ""; /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
+	}
+
+	va_start(xVariableList, szFormat);
+
+	/* Read each argument with the type given by its format specifier */
+	for (i = 0u; (szFormat[i] != (char)0) && (i < 128u); i++) /*cstat !MISRAC2012-Rule-14.2 Suppress malformed for loop due to i being incremented inside*/ /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+	{
+		if (szFormat[i] != '%') /*cstat !MISRAC2004-17.4_b We need to access a specific character in the string*/
+		{
+			continue; /*cstat !MISRAC2004-14.5 Suppress continue usage check*/
+		}
+
+		/* Skip flags, width and precision. A '*' width or precision is an int argument that the host needs as well. */
+		i++; /*cstat !MISRAC2004-13.6 Suppress i increment inside for loop check*/
+		while ((szFormat[i] == '-') || (szFormat[i] == '+') || (szFormat[i] == ' ') || (szFormat[i] == '#') || (szFormat[i] == '.') || (szFormat[i] == '*') || ((szFormat[i] >= '0') && (szFormat[i] <= '9'))) /*cstat !MISRAC2004-17.4_b We need to access a specific character in the string*/
+		{
+			if (szFormat[i] == '*') /*cstat !MISRAC2004-17.4_b We need to access a specific character in the string*/
+			{
+				if (uiArgs >= TRC_PRINT_TYPED_MAX_ARGS)
+				{
+					va_end(xVariableList);
+
+					return TRC_FAIL;
+				}
+
+				uiValue = (uint32_t)va_arg(xVariableList, int);
+				TRC_MEMCPY(&puiPayload[uiOffset], &uiValue, sizeof(uint32_t)); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+				uiOffset += (uint32_t)sizeof(uint32_t);
+				uiDescriptor |= TRC_PRINT_TYPED_ARG_INT32 << (4u + (2u * uiArgs));
+				uiArgs++;
+			}
+			i++; /*cstat !MISRAC2004-13.6 Suppress i increment inside for loop check*/
+		}
+
+		/* Length modifiers, where uiLong is 1 for "l", 2 for "ll", 3 for "j" and 4 for "z" */
+		uiLong = 0u;
+		while ((szFormat[i] == 'h') || (szFormat[i] == 'l') || (szFormat[i] == 'j') || (szFormat[i] == 'z')) /*cstat !MISRAC2004-17.4_b We need to access a specific character in the string*/
+		{
+			if (szFormat[i] == 'l')
+			{
+				uiLong++;
+			}
+			else if (szFormat[i] == 'j')
+			{
+				uiLong = 3u;
+			}
+			else if (szFormat[i] == 'z')
+			{
+				uiLong = 4u;
+			}
+			else
+			{
+				/* Promoted to int */
+			}
+			i++; /*cstat !MISRAC2004-13.6 Suppress i increment inside for loop check*/
+		}
+
+		cSpecifier = szFormat[i]; /*cstat !MISRAC2004-17.4_b We need to access a specific character in the string*/
+
+		if (cSpecifier == (char)0)
+		{
+			/* Found end of string, step back and let for loop detect it */
+			i--; /*cstat !MISRAC2004-13.6 Suppress i increment inside for loop check*/
+			continue; /*cstat !MISRAC2004-14.5 Suppress continue usage check*/
+		}
+
+		if (cSpecifier == '%')
+		{
+			/* Not an argument */
+			continue; /*cstat !MISRAC2004-14.5 Suppress continue usage check*/
+		}
+
+		if ((cSpecifier == 'L') || (uiArgs >= TRC_PRINT_TYPED_MAX_ARGS))
+		{
+			va_end(xVariableList);
+
+			return TRC_FAIL;
+		}
+
+		if ((cSpecifier == 'f') || (cSpecifier == 'F') || (cSpecifier == 'e') || (cSpecifier == 'E') || (cSpecifier == 'g') || (cSpecifier == 'G') || (cSpecifier == 'a') || (cSpecifier == 'A'))
+		{
+			dValue = va_arg(xVariableList, double);
+			TRC_MEMCPY(&puiPayload[uiOffset], &dValue, sizeof(double)); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+			uiOffset += (uint32_t)sizeof(double);
+			uiType = TRC_PRINT_TYPED_ARG_DOUBLE;
+		}
+		else
+		{
+			if ((cSpecifier == 's') || (cSpecifier == 'p'))
+			{
+				ulValue = (uint64_t)(uintptr_t)va_arg(xVariableList, void*); /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+				uiType = (sizeof(void*) > sizeof(uint32_t)) ? TRC_PRINT_TYPED_ARG_INT64 : TRC_PRINT_TYPED_ARG_INT32;
+			}
+			else if (uiLong == 1u)
+			{
+				ulValue = (uint64_t)va_arg(xVariableList, unsigned long);
+				uiType = (sizeof(unsigned long) > sizeof(uint32_t)) ? TRC_PRINT_TYPED_ARG_INT64 : TRC_PRINT_TYPED_ARG_INT32;
+			}
+			else if (uiLong == 2u)
+			{
+				ulValue = (uint64_t)va_arg(xVariableList, unsigned long long);
+				uiType = TRC_PRINT_TYPED_ARG_INT64;
+			}
+			else if (uiLong == 3u)
+			{
+				ulValue = (uint64_t)va_arg(xVariableList, uintmax_t);
+				uiType = (sizeof(uintmax_t) > sizeof(uint32_t)) ? TRC_PRINT_TYPED_ARG_INT64 : TRC_PRINT_TYPED_ARG_INT32;
+			}
+			else if (uiLong == 4u)
+			{
+				ulValue = (uint64_t)va_arg(xVariableList, size_t);
+				uiType = (sizeof(size_t) > sizeof(uint32_t)) ? TRC_PRINT_TYPED_ARG_INT64 : TRC_PRINT_TYPED_ARG_INT32;
+			}
+			else
+			{
+				ulValue = (uint64_t)va_arg(xVariableList, unsigned int);
+				uiType = TRC_PRINT_TYPED_ARG_INT32;
+			}
+
+			if (uiType == TRC_PRINT_TYPED_ARG_INT64)
+			{
+				TRC_MEMCPY(&puiPayload[uiOffset], &ulValue, sizeof(uint64_t)); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+				uiOffset += (uint32_t)sizeof(uint64_t);
+			}
+			else
+			{
+				uiValue = (uint32_t)ulValue;
+				TRC_MEMCPY(&puiPayload[uiOffset], &uiValue, sizeof(uint32_t)); /*cstat !MISRAC2004-17.4_b We need to access a specific part of the buffer*/
+				uiOffset += (uint32_t)sizeof(uint32_t);
+			}
+		}
+
+		uiDescriptor |= uiType << (4u + (2u * uiArgs));
+		uiArgs++;
+	}
+
+	va_end(xVariableList);
+
+	uiDescriptor |= uiArgs;
+
+	return xTraceEventCreateData3(PSF_EVENT_USER_EVENT_TYPED, (TraceUnsignedBaseType_t)szChannel, (TraceUnsignedBaseType_t)szFormat, (TraceUnsignedBaseType_t)uiDescriptor, auxPayload, uiOffset); /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+}
+
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-16.1 Suppress variable parameter count check*/
 traceResult xTracePrintF(TraceStringHandle_t xChannel, const char* szFormat, ...)
 {
@@ -181,6 +378,28 @@ traceResult xTracePrintF(TraceStringHandle_t xChannel, const char* szFormat, ...
 	return xResult;
 }
 
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-16.1 Suppress variable parameter count check*/
+traceResult xTracePrintLiteral(TraceStringHandle_t xChannel, const char* szFormat, uint32_t uiLength, uint32_t uiArgs, ...)
+{
+	traceResult xResult;
+	va_list xVariableList; /*cstat !MISRAC2012-Rule-17.1 Suppress stdarg usage check*/
+
+	/* We need to check this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_FAIL;
+	}
+
+	/* This should never fail */
+	TRC_ASSERT(uiArgs <= 5u);
+
+	va_start(xVariableList, uiArgs);
+	xResult = prvTraceVPrintF(xChannel, szFormat, uiLength, uiArgs, &xVariableList);
+	va_end(xVariableList);
+
+	return xResult;
+}
+
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2012-Rule-17.1 Suppress stdarg usage check*/
 traceResult xTraceVPrintF(TraceStringHandle_t xChannel, const char* szFormat, va_list* pxVariableList)
 {
@@ -238,17 +457,18 @@ static traceResult prvTraceVPrintF(TraceStringHandle_t xChannel, const char* szF
 
 	if (xChannel == 0)
 	{
-		if (pxPrintData->defaultChannel == 0)
+		if (prvTraceGetDefaultChannel(&xChannel) == TRC_FAIL) /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
 		{
-			/* Channel is not present */
-			if (xTraceStringRegister("Default", &pxPrintData->defaultChannel) == TRC_FAIL)
-			{
-				return TRC_FAIL;
-			}
+			return TRC_FAIL;
 		}
+	}
 
-		xChannel = pxPrintData->defaultChannel; /*cstat !MISRAC2012-Rule-17.8 Suppress modified function parameter check*/
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+	if (xTracePrintChannelCheck((TraceUnsignedBaseType_t)xChannel) == TRC_FAIL)
+	{
+		return TRC_SUCCESS;
 	}
+#endif
 
 	switch (uiArgs)
 	{
@@ -333,4 +553,244 @@ static traceResult prvTraceVPrintF(TraceStringHandle_t xChannel, const char* szF
 	return xResult;
 }
 
+static traceResult prvTraceGetDefaultChannel(TraceStringHandle_t* pxChannel)
+{
+	if (pxPrintData->defaultChannel == 0)
+	{
+		/* Channel is not present */
+		if (xTraceStringRegister("Default", &pxPrintData->defaultChannel) == TRC_FAIL)
+		{
+			return TRC_FAIL;
+		}
+	}
+
+	*pxChannel = pxPrintData->defaultChannel;
+
+	return TRC_SUCCESS;
+}
+
+#if (TRC_CFG_PRINT_CHANNEL_LIMITS > 0)
+
+traceResult xTracePrintSetChannelLimit(TraceStringHandle_t xChannel, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate)
+{
+	/* We need to check this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_FAIL;
+	}
+
+	if (xChannel == 0)
+	{
+		if (prvTraceGetDefaultChannel(&xChannel) == TRC_FAIL)
+		{
+			return TRC_FAIL;
+		}
+	}
+
+	return prvTracePrintSetChannelLimit((TraceUnsignedBaseType_t)xChannel, 0u, uiBurst, uiTicksPerToken, uiSampleRate);
+}
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+traceResult xTracePrintCompactSetChannelLimit(const char* szChannel, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate)
+{
+	/* We need to check this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_FAIL;
+	}
+
+	return prvTracePrintSetChannelLimit((TraceUnsignedBaseType_t)szChannel, 1u, uiBurst, uiTicksPerToken, uiSampleRate); /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+}
+
+traceResult xTracePrintChannelCheck(TraceUnsignedBaseType_t uxChannel)
+{
+	TracePrintChannelLimit_t* pxLimit;
+	TraceUnsignedBaseType_t i;
+	uint32_t uiTimestamp = 0u;
+	uint32_t uiNewTokens;
+	traceResult xResult = TRC_SUCCESS;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* Limits can't have been set before this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_SUCCESS;
+	}
+
+	if (pxPrintData->uxChannelLimitsUsed == 0u)
+	{
+		return TRC_SUCCESS;
+	}
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	for (i = 0u; i < pxPrintData->uxChannelLimitsUsed; i++)
+	{
+		pxLimit = &pxPrintData->xChannelLimits[i];
+
+		if (pxLimit->uxChannel != uxChannel)
+		{
+			continue; /*cstat !MISRAC2004-14.5 Suppress continue usage check*/
+		}
+
+		/* Keep the first event and then every uiSampleRate:th */
+		if (pxLimit->uiSampleRate > 1u)
+		{
+			if (pxLimit->uiSampleCounter != 0u)
+			{
+				xResult = TRC_FAIL;
+			}
+
+			pxLimit->uiSampleCounter++;
+			if (pxLimit->uiSampleCounter == pxLimit->uiSampleRate)
+			{
+				pxLimit->uiSampleCounter = 0u;
+			}
+		}
+
+		if ((xResult == TRC_SUCCESS) && (pxLimit->uiBurst > 0u))
+		{
+			if (pxLimit->uiTicksPerToken > 0u)
+			{
+				(void)xTraceTimestampGet(&uiTimestamp);
+
+				uiNewTokens = (uiTimestamp - pxLimit->uiLastRefill) / pxLimit->uiTicksPerToken;
+				if (uiNewTokens >= (pxLimit->uiBurst - pxLimit->uiTokens))
+				{
+					pxLimit->uiTokens = pxLimit->uiBurst;
+					pxLimit->uiLastRefill = uiTimestamp;
+				}
+				else
+				{
+					pxLimit->uiTokens += uiNewTokens;
+					pxLimit->uiLastRefill += uiNewTokens * pxLimit->uiTicksPerToken;
+				}
+			}
+
+			if (pxLimit->uiTokens > 0u)
+			{
+				pxLimit->uiTokens--;
+			}
+			else
+			{
+				xResult = TRC_FAIL;
+			}
+		}
+
+		if (xResult == TRC_FAIL)
+		{
+			pxLimit->uiSuppressed++;
+		}
+
+		break;
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return xResult;
+}
+
+traceResult xTracePrintReportSuppressed(void)
+{
+	TracePrintChannelLimit_t* pxLimit;
+	TraceUnsignedBaseType_t i;
+	uint32_t uiSuppressed;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* We need to check this */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_PRINT) == 0U)
+	{
+		return TRC_FAIL;
+	}
+
+	for (i = 0u; i < pxPrintData->uxChannelLimitsUsed; i++)
+	{
+		pxLimit = &pxPrintData->xChannelLimits[i];
+
+		TRACE_ENTER_CRITICAL_SECTION();
+		uiSuppressed = pxLimit->uiSuppressed;
+		pxLimit->uiSuppressed = 0u;
+		TRACE_EXIT_CRITICAL_SECTION();
+
+		if (uiSuppressed == 0u)
+		{
+			continue; /*cstat !MISRAC2004-14.5 Suppress continue usage check*/
+		}
+
+		/* Stored directly, so the report itself is never suppressed */
+		if (pxLimit->uiCompact != 0u)
+		{
+			(void)xTraceEventCreate3(PSF_EVENT_USER_EVENT_FIXED + 1UL, pxLimit->uxChannel, (TraceUnsignedBaseType_t)szPrintSuppressedFormat, (TraceUnsignedBaseType_t)uiSuppressed); /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 We need the addresses*/
+		}
+		else
+		{
+			(void)xTraceEventCreateData2(PSF_EVENT_USER_EVENT + 2UL, pxLimit->uxChannel, (TraceUnsignedBaseType_t)uiSuppressed, (const TraceUnsignedBaseType_t*)szPrintSuppressedFormat, sizeof(TRC_PRINT_SUPPRESSED_FORMAT)); /*cstat !MISRAC2012-Rule-11.3 Suppress conversion between pointer types checks*/
+		}
+	}
+
+	return TRC_SUCCESS;
+}
+
+static traceResult prvTracePrintSetChannelLimit(TraceUnsignedBaseType_t uxChannel, uint32_t uiCompact, uint32_t uiBurst, uint32_t uiTicksPerToken, uint32_t uiSampleRate)
+{
+	TracePrintChannelLimit_t* pxLimit = (void*)0;
+	TraceUnsignedBaseType_t i;
+	uint32_t uiTimestamp = 0u;
+	traceResult xResult = TRC_SUCCESS;
+
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+
+	for (i = 0u; i < pxPrintData->uxChannelLimitsUsed; i++)
+	{
+		if (pxPrintData->xChannelLimits[i].uxChannel == uxChannel)
+		{
+			pxLimit = &pxPrintData->xChannelLimits[i];
+			break;
+		}
+	}
+
+	if (pxLimit == (void*)0)
+	{
+		if (pxPrintData->uxChannelLimitsUsed < (TraceUnsignedBaseType_t)(TRC_CFG_PRINT_CHANNEL_LIMITS))
+		{
+			pxLimit = &pxPrintData->xChannelLimits[pxPrintData->uxChannelLimitsUsed];
+			pxLimit->uiSuppressed = 0u;
+		}
+		else
+		{
+			xResult = TRC_FAIL;
+		}
+	}
+
+	if (pxLimit != (void*)0)
+	{
+		(void)xTraceTimestampGet(&uiTimestamp);
+
+		pxLimit->uiCompact = uiCompact;
+		pxLimit->uiBurst = uiBurst;
+		pxLimit->uiTokens = uiBurst;
+		pxLimit->uiTicksPerToken = uiTicksPerToken;
+		pxLimit->uiLastRefill = uiTimestamp;
+		pxLimit->uiSampleRate = uiSampleRate;
+		pxLimit->uiSampleCounter = 0u;
+
+		if (pxLimit == &pxPrintData->xChannelLimits[pxPrintData->uxChannelLimitsUsed])
+		{
+			/* New slot, fully set up before it is counted */
+			pxLimit->uxChannel = uxChannel;
+			pxPrintData->uxChannelLimitsUsed++;
+		}
+	}
+
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return xResult;
+}
+
+#endif
+
 #endif
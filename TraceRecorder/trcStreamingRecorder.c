@@ -58,7 +58,12 @@ typedef struct TraceCommandType_t
 #endif
 
 /* Used to interpret the data format */
+#if ((TRC_CFG_USE_COMPACT_TIMESTAMPS == 1) || (TRC_CFG_USE_PACKED_EVENT_PARAMETERS == 1) || (TRC_CFG_USE_EVENT_COALESCING == 1))
+/* Compact event headers, packed event parameters and/or repeat events, see the header options */
+#define TRACE_FORMAT_VERSION ((uint16_t)0x000F)
+#else
 #define TRACE_FORMAT_VERSION ((uint16_t)0x000E)
+#endif
 
 /* Used to determine endian of data (big/little) */
 #define TRACE_PSF_ENDIANESS_IDENTIFIER ((uint32_t)0x50534600)
@@ -100,6 +105,12 @@ static void prvTraceStoreTimestampInfo(void);
 /* Stores the entry table on Start */
 static void prvTraceStoreEntryTable(void);
 
+/* Stores the entry table header with the current entry count */
+static void prvTraceStoreEntryTableHeader(void);
+
+/* Stores up to uiMaxEntries used entries, starting at uiFirstSlot. Returns the slot to continue from. */
+static uint32_t prvTraceStoreEntryTableSlots(uint32_t uiFirstSlot, uint32_t uiMaxEntries);
+
 #else /* (TRC_EXTERNAL_BUFFERS == 0) */
 
 #define prvTraceStoreHeader() 
@@ -108,6 +119,17 @@ static void prvTraceStoreEntryTable(void);
 
 #endif /* (TRC_EXTERNAL_BUFFERS == 0) */
 
+/* The entry table can only be stored in chunks when it goes to the internal
+ * buffer, since the start sequence is redone if the table changes meanwhile. */
+#if (TRC_EXTERNAL_BUFFERS == 0) && (TRC_USE_INTERNAL_BUFFER == 1) && ((TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE) > 0)
+#define TRC_ENTRY_TABLE_STORE_CHUNKED 1
+#else
+#define TRC_ENTRY_TABLE_STORE_CHUNKED 0
+#endif
+
+/* Resets the session statistics and stores the header and timestamp info */
+static void prvTraceStoreSessionInfo(void);
+
 /* Store start event. */
 static void prvTraceStoreStartEvent(void);
 
@@ -123,6 +145,9 @@ static void prvSetRecorderEnabled(void);
 /* Internal function for stopping the recorder */
 static void prvSetRecorderDisabled(void);
 
+/* Internal function for enabling or disabling event groups */
+static void prvSetEventGroupFilter(uint32_t uiFirstGroup, uint32_t uiLastGroup, uint32_t uiEnabled);
+
 /* Internal function for verifying size */
 static traceResult prvVerifySizeAlignment(uint32_t ulSize);
 
@@ -254,6 +279,13 @@ traceResult xTraceInitialize(void)
 	{
 		return TRC_FAIL;
 	}
+
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+	if (xTraceStringInitialize(&pxTraceRecorderData->xStringBuffer) == TRC_FAIL)
+	{
+		return TRC_FAIL;
+	}
+#endif
 	
 	if (xTraceErrorInitialize(&pxTraceRecorderData->xErrorBuffer) == TRC_FAIL)
 	{
@@ -352,6 +384,21 @@ traceResult xTraceHeaderInitialize(TraceHeaderBuffer_t *pxBuffer)
 		pxHeader->uiOptions |= (1 << 3);
 	}
 
+	/* 5th bit used for TRC_CFG_USE_COMPACT_TIMESTAMPS */
+	pxHeader->uiOptions |= (((uint32_t)(TRC_CFG_USE_COMPACT_TIMESTAMPS)) << 4);
+
+	/* 6th bit used for TRC_CFG_USE_PACKED_EVENT_PARAMETERS. Events with parameter count 15 then hold a
+	 * length byte followed by that many bytes of parameters, each encoded as a zigzag LEB128 varint,
+	 * padded to the parameter size. Other events have at most 14 parameters. */
+	pxHeader->uiOptions |= (((uint32_t)(TRC_CFG_USE_PACKED_EVENT_PARAMETERS)) << 5);
+
+	/* 7th bit used for TRC_CFG_USE_EVENT_COALESCING. A PSF_EVENT_REPEAT event with parameters
+	 * (count, timestamp, stride) then means that the latest event on that core created with
+	 * xTraceEventCreate0-6 was repeated count more times, the last time at timestamp, with its last
+	 * parameter increasing by stride each time. A fourth parameter, if present, is the core the
+	 * repeats belong to, when they were written on another core. */
+	pxHeader->uiOptions |= (((uint32_t)(TRC_CFG_USE_EVENT_COALESCING)) << 6);
+
 	return TRC_SUCCESS;
 }
 
@@ -481,6 +528,9 @@ traceResult xTraceTzCtrl(void)
 
 		if (xTraceIsRecorderEnabled())
 		{
+			/* Don't hold back repeat counts while the system is idle */
+			(void)xTraceEventFlushRepeats();
+
 			(void)xTraceInternalEventBufferTransfer();
 		}
 
@@ -493,6 +543,8 @@ traceResult xTraceTzCtrl(void)
 	{
 		(void)xTraceDiagnosticsCheckStatus();
 		(void)xTraceStackMonitorReport();
+		(void)xTraceEventStatisticsReport();
+		(void)xTracePrintReportSuppressed();
 	}
 
 	return TRC_SUCCESS;
@@ -512,6 +564,12 @@ static void prvSetRecorderEnabled(void)
 {
 	TraceUnsignedBaseType_t uxTimestampFrequency = 0u;
 	uint32_t uiTimestampPeriod = 0u;
+#if (TRC_ENTRY_TABLE_STORE_CHUNKED == 1)
+	uint32_t uiSlot = 0u;
+	uint32_t uiCore;
+	uint32_t uiChangeCount = 0u;
+	uint32_t uiCurrentChangeCount = 0u;
+#endif
 	
 	TRACE_ALLOC_CRITICAL_SECTION();
 	
@@ -541,9 +599,47 @@ static void prvSetRecorderEnabled(void)
 	
 	(void)xTraceStreamPortOnTraceBegin();
 
-	prvTraceStoreHeader();
-	prvTraceStoreTimestampInfo();
+	prvTraceStoreSessionInfo();
+
+#if (TRC_ENTRY_TABLE_STORE_CHUNKED == 1)
+	/* Store the entry table a few entries at a time and let other tasks and
+	 * interrupts run in between. The recorder is still disabled, so nothing
+	 * else is written to or transferred from the internal buffer meanwhile. */
+	(void)xTraceEntryGetChangeCount(&uiChangeCount);
+	uiCore = (uint32_t)TRC_CFG_GET_CURRENT_CORE();
+
+	prvTraceStoreEntryTableHeader();
+
+	while (uiSlot < (uint32_t)(TRC_ENTRY_TABLE_SLOTS))
+	{
+		uiSlot = prvTraceStoreEntryTableSlots(uiSlot, (uint32_t)(TRC_CFG_ENTRY_TABLE_STORE_CHUNK_SIZE));
+
+		TRACE_EXIT_CRITICAL_SECTION();
+		TRACE_ENTER_CRITICAL_SECTION();
+
+		(void)xTraceEntryGetChangeCount(&uiCurrentChangeCount);
+
+		if ((uiCurrentChangeCount != uiChangeCount) || ((uint32_t)TRC_CFG_GET_CURRENT_CORE() != uiCore))
+		{
+			/* The stored entries no longer match the header, or the rest would
+			 * end up in another core's buffer. Start over in one go. */
+			(void)xTraceInternalEventBufferClear();
+			prvTraceStoreSessionInfo();
+			prvTraceStoreEntryTable();
+
+			break;
+		}
+	}
+#else /* (TRC_ENTRY_TABLE_STORE_CHUNKED == 1) */
 	prvTraceStoreEntryTable();
+#endif /* (TRC_ENTRY_TABLE_STORE_CHUNKED == 1) */
+
+	/* The first event of the session must carry a full timestamp */
+	(void)xTraceEventSyncTimestamps();
+
+	/* Repeats can't refer to events from a previous session */
+	(void)xTraceEventResetRepeats();
+
 	prvTraceStoreStartEvent();
 
 	pxTraceRecorderData->uiSessionCounter++;
@@ -587,11 +683,16 @@ static void prvTraceStoreTimestampInfo(void)
 /* Stores the entry table on Start */
 static void prvTraceStoreEntryTable(void)
 {
-	uint32_t i = 0;
-	TraceEntryHandle_t xEntryHandle;
+	prvTraceStoreEntryTableHeader();
+
+	(void)prvTraceStoreEntryTableSlots(0u, (uint32_t)(TRC_ENTRY_TABLE_SLOTS));
+}
+
+/* Stores the entry table header with the current entry count */
+static void prvTraceStoreEntryTableHeader(void)
+{
 	uint32_t uiEntryCount;
 	TraceUnsignedBaseType_t xHeaderData[3];
-	void *pvEntryAddress;
 
 	(void)xTraceEntryGetCount(&uiEntryCount);
 
@@ -600,8 +701,20 @@ static void prvTraceStoreEntryTable(void)
 	xHeaderData[2] = TRC_ENTRY_TABLE_STATE_COUNT;
 
 	xTraceEventCreateRawBlocking(xHeaderData, sizeof(xHeaderData));
+}
+
+/* Stores up to uiMaxEntries used entries, starting at uiFirstSlot. Returns the slot to continue from. */
+static uint32_t prvTraceStoreEntryTableSlots(uint32_t uiFirstSlot, uint32_t uiMaxEntries)
+{
+	uint32_t i;
+	uint32_t uiStored = 0u;
+	TraceEntryHandle_t xEntryHandle;
+	void *pvEntryAddress;
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+	TraceEntryStored_t xStoredEntry;
+#endif
 
-	for (i = 0; i < (TRC_ENTRY_TABLE_SLOTS); i++)
+	for (i = uiFirstSlot; (i < (uint32_t)(TRC_ENTRY_TABLE_SLOTS)) && (uiStored < uiMaxEntries); i++)
 	{
 		(void)xTraceEntryGetAtIndex(i, &xEntryHandle);
 		(void)xTraceEntryGetAddress(xEntryHandle, &pvEntryAddress);
@@ -609,13 +722,34 @@ static void prvTraceStoreEntryTable(void)
 		/* We only send used entry slots */
 		if (pvEntryAddress != 0)
 		{
+#if ((TRC_CFG_ENTRY_SYMBOL_POOL_SIZE) > 0)
+			/* The host expects a full length symbol in every entry */
+			(void)xTraceEntryGetStored(xEntryHandle, &xStoredEntry);
+			xTraceEventCreateRawBlocking(&xStoredEntry, sizeof(TraceEntryStored_t));
+#else
 			xTraceEventCreateRawBlocking((TraceUnsignedBaseType_t *) xEntryHandle, sizeof(TraceEntry_t));
+#endif
+			uiStored++;
 		}
 	}
 
+	return i;
 }
 #endif /* (TRC_EXTERNAL_BUFFERS == 0) */
 
+/* Resets the session statistics and stores the header and timestamp info */
+static void prvTraceStoreSessionInfo(void)
+{
+	/* The statistics cover this session, including the header data below */
+	(void)xTraceEventStatisticsReset();
+
+	/* Losses from a previous session are not reported */
+	(void)xTraceEventDroppedReset();
+
+	prvTraceStoreHeader();
+	prvTraceStoreTimestampInfo();
+}
+
 static void prvTraceStoreStartEvent(void)
 {
 	void* pvCurrentTask = (void*)0;
@@ -631,6 +765,25 @@ static void prvTraceStoreStartEvent(void)
 	(void)xTraceEventCreateDataOffline0(PSF_EVENT_TRACE_START, xTraceTasks, sizeof(xTraceTasks));
 }
 
+/* Enables or disables a range of event groups, requested by the host */
+static void prvSetEventGroupFilter(uint32_t uiFirstGroup, uint32_t uiLastGroup, uint32_t uiEnabled)
+{
+	uint32_t i;
+
+	/* The command parameters are bytes, so the range always holds valid groups */
+	for (i = uiFirstGroup; i <= uiLastGroup; i++)
+	{
+		if (uiEnabled == 1u)
+		{
+			(void)xTraceEventGroupEnable(i);
+		}
+		else
+		{
+			(void)xTraceEventGroupDisable(i);
+		}
+	}
+}
+
 /* Checks if the provided command is a valid command */
 static int32_t prvIsValidCommand(const TraceCommand_t* const cmd)
 {
@@ -674,6 +827,9 @@ static void prvProcessCommand(const TraceCommand_t* const cmd)
 				prvSetRecorderDisabled();
 			}
 		  	break;
+		case CMD_SET_EVENT_GROUP_FILTER:
+			prvSetEventGroupFilter(cmd->param1, cmd->param2, cmd->param3);
+			break;
 		default:
 		  	break;
 	}
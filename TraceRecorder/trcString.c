@@ -12,28 +12,131 @@
 
 #if (TRC_USE_TRACEALYZER_RECORDER == 1)
 
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+
+#include <string.h>
+
+static TraceStringData_t *pxStringData TRC_CFG_RECORDER_DATA_ATTRIBUTE;
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static uint32_t prvStringRegistryHash(const char* szString, uint32_t uiLength);
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvStringRegistryFind(const char* szString, uint32_t uiLength, TraceStringHandle_t* pString);
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static void prvStringRegistryAdd(const char* szString, uint32_t uiLength, TraceStringHandle_t xString);
+
+#endif /* ((TRC_CFG_STRING_REGISTRY_SIZE) > 0) */
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvStringCreateEntry(const char* szString, uint32_t uiLength, TraceStringHandle_t* pString);
+
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+
+traceResult xTraceStringInitialize(TraceStringData_t* pxBuffer)
+{
+	uint32_t i;
+
+	/* This should never fail */
+	TRC_ASSERT(pxBuffer != (void*)0);
+
+	pxStringData = pxBuffer;
+
+	for (i = 0u; i < (uint32_t)(TRC_CFG_STRING_REGISTRY_SIZE); i++)
+	{
+		pxStringData->xSlots[i].szString = (void*)0;
+		pxStringData->xSlots[i].xString = 0;
+	}
+
+	pxStringData->uxSlotsUsed = 0u;
+
+	(void)xTraceSetComponentInitialized(TRC_RECORDER_COMPONENT_STRING);
+
+	return TRC_SUCCESS;
+}
+
+#endif /* ((TRC_CFG_STRING_REGISTRY_SIZE) > 0) */
+
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
 traceResult xTraceStringRegister(const char* szString, TraceStringHandle_t *pString)
 {
-	TraceEntryHandle_t xEntryHandle;
+	traceResult xResult;
 	int32_t i;
 	uint32_t uiLength = 0u;
 
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+	TRACE_ALLOC_CRITICAL_SECTION();
+#endif
+
 	/* This should never fail */
 	TRC_ASSERT(szString != (void*)0);
 	
 	/* This should never fail */
 	TRC_ASSERT(pString != (void*)0);
 
+	for (i = 0; (szString[i] != (char)0) && (i < (int32_t)(TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE)); i++) {} /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+
+	uiLength = (uint32_t)i;
+
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+	/* Strings can be registered before the registry is initialized */
+	if (xTraceIsComponentInitialized(TRC_RECORDER_COMPONENT_STRING) != 0U)
+	{
+		/* The lookup and the registration are made in one critical section, so a string registered concurrently only gets one entry */
+		TRACE_ENTER_CRITICAL_SECTION();
+
+		/* A string that is already registered is reused as is */
+		if (prvStringRegistryFind(szString, uiLength, pString) == TRC_SUCCESS)
+		{
+			TRACE_EXIT_CRITICAL_SECTION();
+
+			return TRC_SUCCESS;
+		}
+
+		xResult = prvStringCreateEntry(szString, uiLength, pString);
+
+		if (xResult == TRC_SUCCESS)
+		{
+			prvStringRegistryAdd(szString, uiLength, *pString);
+		}
+
+		TRACE_EXIT_CRITICAL_SECTION();
+	}
+	else
+	{
+		xResult = prvStringCreateEntry(szString, uiLength, pString);
+	}
+#else
+	xResult = prvStringCreateEntry(szString, uiLength, pString);
+#endif
+
 	/* We need to check this */
-	if (xTraceEntryCreate(&xEntryHandle) == TRC_FAIL)
+	if (xResult == TRC_FAIL)
 	{
 		return TRC_FAIL;
 	}
 
-	for (i = 0; (szString[i] != (char)0) && (i < (int32_t)(TRC_ENTRY_TABLE_SLOT_SYMBOL_SIZE)); i++) {} /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/ /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+	return xTraceEventCreateData1(PSF_EVENT_OBJ_NAME, (TraceUnsignedBaseType_t)*pString, (TraceUnsignedBaseType_t*)szString, uiLength + 1);
+}
 
-	uiLength = (uint32_t)i;
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+TraceStringHandle_t xTraceRegisterString(const char *name)
+{
+	TraceStringHandle_t trcStr = 0;
+	(void)xTraceStringRegister(name, &trcStr);
+
+	return trcStr;
+}
+
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvStringCreateEntry(const char* szString, uint32_t uiLength, TraceStringHandle_t* pString)
+{
+	TraceEntryHandle_t xEntryHandle;
+
+	/* We need to check this */
+	if (xTraceEntryCreate(&xEntryHandle) == TRC_FAIL)
+	{
+		return TRC_FAIL;
+	}
 
 	/* The address to the available symbol table slot is the address we use */
 	/* This should never fail */
@@ -41,16 +144,107 @@ traceResult xTraceStringRegister(const char* szString, TraceStringHandle_t *pStr
 
 	*pString = (TraceStringHandle_t)xEntryHandle;
 
-	return xTraceEventCreateData1(PSF_EVENT_OBJ_NAME, (TraceUnsignedBaseType_t)xEntryHandle, (TraceUnsignedBaseType_t*)szString, uiLength + 1);
+	return TRC_SUCCESS;
 }
 
+#if ((TRC_CFG_STRING_REGISTRY_SIZE) > 0)
+
 /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
-TraceStringHandle_t xTraceRegisterString(const char *name)
+static uint32_t prvStringRegistryHash(const char* szString, uint32_t uiLength)
 {
-	TraceStringHandle_t trcStr = 0;
-	(void)xTraceStringRegister(name, &trcStr);
+	uint32_t uiHash;
+#if (TRC_CFG_STRING_REGISTRY_MATCH_CONTENT == 1)
+	uint32_t i;
 
-	return trcStr;
+	/* FNV-1a over the characters that are kept in the symbol */
+	uiHash = 2166136261UL;
+	for (i = 0u; (i < uiLength) && (i < (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH)); i++)
+	{
+		uiHash ^= (uint32_t)(uint8_t)szString[i]; /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+		uiHash *= 16777619UL;
+	}
+#else
+	TraceUnsignedBaseType_t uxAddress = (TraceUnsignedBaseType_t)szString; /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 Suppress conversion from pointer to integer check*/
+
+	(void)uiLength;
+
+	/* Fold in the upper half of 64-bit addresses and mix the high bits down, since strings are often aligned */
+	uiHash = (uint32_t)(uxAddress ^ ((uxAddress >> 16) >> 16));
+	uiHash *= 2654435761UL;
+	uiHash ^= uiHash >> 16;
+#endif
+
+	return uiHash % (uint32_t)(TRC_CFG_STRING_REGISTRY_SIZE);
+}
+
+/* Must be called from within the critical section */
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static traceResult prvStringRegistryFind(const char* szString, uint32_t uiLength, TraceStringHandle_t* pString)
+{
+	uint32_t uiSlot;
+	uint32_t uiProbes;
+	uint32_t uiCompareLength;
+	TraceStringRegistrySlot_t* pxSlot;
+	const char* szSymbol; /*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+
+	/* Only the characters kept in the symbol can be compared */
+	uiCompareLength = (uiLength < (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH)) ? uiLength : (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH);
+
+	uiSlot = prvStringRegistryHash(szString, uiLength);
+
+	for (uiProbes = 0u; uiProbes < (uint32_t)(TRC_CFG_STRING_REGISTRY_SIZE); uiProbes++)
+	{
+		pxSlot = &pxStringData->xSlots[uiSlot];
+
+		if (pxSlot->szString == (void*)0)
+		{
+			break;
+		}
+
+#if (TRC_CFG_STRING_REGISTRY_MATCH_CONTENT == 0)
+		if (pxSlot->szString == szString)
+#endif
+		{
+			/* The content is always verified, since the same buffer may be reused for another string */
+			(void)xTraceEntryGetSymbol((TraceEntryHandle_t)pxSlot->xString, &szSymbol);
+
+			if ((strncmp(szSymbol, szString, uiCompareLength) == 0) &&
+				((uiCompareLength == (uint32_t)(TRC_ENTRY_TABLE_SYMBOL_LENGTH)) || (szSymbol[uiCompareLength] == (char)0))) /*cstat !MISRAC2004-17.4_b We need to access every character in the string*/
+			{
+				*pString = pxSlot->xString;
+
+				return TRC_SUCCESS;
+			}
+		}
+
+		uiSlot = (uiSlot + 1u) % (uint32_t)(TRC_CFG_STRING_REGISTRY_SIZE);
+	}
+
+	return TRC_FAIL;
+}
+
+/* Must be called from within the critical section */
+/*cstat !MISRAC2004-6.3 !MISRAC2012-Dir-4.6_a Suppress basic char type usage*/
+static void prvStringRegistryAdd(const char* szString, uint32_t uiLength, TraceStringHandle_t xString)
+{
+	uint32_t uiSlot;
+
+	uiSlot = prvStringRegistryHash(szString, uiLength);
+
+	/* When the registry is full, strings are still registered but not reused */
+	if (pxStringData->uxSlotsUsed < (TraceUnsignedBaseType_t)(TRC_CFG_STRING_REGISTRY_SIZE))
+	{
+		while (pxStringData->xSlots[uiSlot].szString != (void*)0)
+		{
+			uiSlot = (uiSlot + 1u) % (uint32_t)(TRC_CFG_STRING_REGISTRY_SIZE);
+		}
+
+		pxStringData->xSlots[uiSlot].szString = szString;
+		pxStringData->xSlots[uiSlot].xString = xString;
+		pxStringData->uxSlotsUsed++;
+	}
 }
 
+#endif /* ((TRC_CFG_STRING_REGISTRY_SIZE) > 0) */
+
 #endif
@@ -79,6 +79,8 @@ traceResult xTraceTaskSetPriorityWithoutHandle(void* pvTask, TraceUnsignedBaseTy
 traceResult xTraceTaskSwitch(void *pvTask, TraceUnsignedBaseType_t uxPriority)
 {
 	traceResult xResult = TRC_FAIL;
+	TraceEventBatch_t xBatch;
+	TraceUnsignedBaseType_t uxParams[2];
 #if (TRC_KERNEL_PORT_KERNEL_CAN_SWITCH_TO_SAME_TASK == 1)
 	void* pvCurrent = (void*)0;
 #endif
@@ -112,7 +114,14 @@ traceResult xTraceTaskSwitch(void *pvTask, TraceUnsignedBaseType_t uxPriority)
 	{
 		(void)xTraceTaskSetCurrent(pvTask);
 
-		xResult = xTraceEventCreate2(PSF_EVENT_TASK_ACTIVATE, (TraceUnsignedBaseType_t)pvTask, uxPriority);  /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6 Suppress conversion from pointer to integer check*/
+		/* The task switch is batched with a pending lost events marker, repeat count or sync event, if any */
+		if (xTraceEventBatchBegin(&xBatch) == TRC_SUCCESS)
+		{
+			uxParams[0] = (TraceUnsignedBaseType_t)pvTask;  /*cstat !MISRAC2004-11.3 !MISRAC2012-Rule-11.4 !MISRAC2012-Rule-11.6 Suppress conversion from pointer to integer check*/
+			uxParams[1] = uxPriority;
+			(void)xTraceEventBatchAdd(&xBatch, PSF_EVENT_TASK_ACTIVATE, uxParams, 2u);
+			xResult = xTraceEventBatchCommit(&xBatch);
+		}
 	}
 
 	(void)xTraceStateSet(TRC_STATE_IN_APPLICATION);